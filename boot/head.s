@@ -201,14 +201,59 @@ setup_paging:
 				/* 페이지를 거꾸로 채움 - 더 효율적 :-) */
 	subl $0x1000,%eax
 	jge 1b
-	xorl %eax,%eax		/* pg_dir is at 0x0000 */
+	cld
+/*
+ * If the CPU has 4MB pages (PSE), map the 8Mb with two of them instead
+ * of pg0/pg1, and if it has global pages (PGE) mark them global, so the
+ * kernel's TLB entries survive the cr3 reloads of invalidate(). Without
+ * CPUID the 4kB tables above stay in use.
+ * CPU에 4MB 페이지(PSE)가 있으면 8Mb를 pg0/pg1 대신 그 두 개로 매핑하고,
+ * 전역 페이지(PGE)가 있으면 전역으로 표시하여 커널의 TLB 엔트리가
+ * invalidate()의 cr3 재로드에도 살아남게 합니다. CPUID가 없으면 위의 4kB
+ * 테이블을 계속 사용합니다.
+ */
+	pushfl			/* can the ID flag be toggled? */
+				/* ID 플래그를 바꿀 수 있는가? */
+	popl %eax
+	movl %eax,%ecx
+	xorl $0x200000,%eax
+	pushl %eax
+	popfl
+	pushfl
+	popl %eax
+	pushl %ecx
+	popfl
+	xorl %ecx,%eax
+	testl $0x200000,%eax
+	je 2f
+	movl $1,%eax
+	cpuid
+	testl $0x08,%edx	/* PSE */
+	je 2f
+	movl %cr4,%eax
+	orl $0x10,%eax		/* cr4.PSE */
+	xorl %ecx,%ecx
+	testl $0x2000,%edx	/* PGE */
+	je 1f
+	orl $0x80,%eax		/* cr4.PGE */
+	movl $0x100,%ecx	/* global bit / 전역 비트 */
+1:	movl %eax,%cr4
+	leal 0x87(%ecx),%eax	/* 4Mb page, r/w user, p / 4Mb 페이지 */
+	movl %eax,pg_dir
+	addl $0x400000,%eax
+	movl %eax,pg_dir+4
+2:	xorl %eax,%eax		/* pg_dir is at 0x0000 */
 				/* pg_dir는 0x0000에 있습니다 */
 	movl %eax,%cr3		/* cr3 - page directory start */
 				/* cr3 - 페이지 디렉터리 시작 */
 	movl %cr0,%eax
-	orl $0x80000000,%eax
-	movl %eax,%cr0		/* set paging (PG) bit */
-				/* 페이징 (PG) 비트 설정 */
+	orl $0x80010000,%eax
+	movl %eax,%cr0		/* set paging (PG) and write protect (WP) bits */
+				/* 페이징 (PG) 및 쓰기 보호 (WP) 비트 설정 */
+				/* WP: kernel writes to read-only user pages fault
+				   too, so shared pages get copied */
+				/* WP: 커널이 읽기 전용 사용자 페이지에 써도 폴트가
+				   나므로 공유 페이지가 복사됨 */
 	ret			/* this also flushes prefetch-queue */
 				/* 이것은 또한 prefetch-queue를 플러시합니다 */
 
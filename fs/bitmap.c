@@ -125,10 +125,8 @@ void free_inode(struct m_inode * inode)
 
 	if (!inode)
 		return;
-	if (!inode->i_dev) {
-		memset(inode,0,sizeof(*inode));
+	if (!inode->i_dev)
 		return;
-	}
 	if (inode->i_count>1) {
 		printk("trying to free inode with count=%d\n",inode->i_count);
 		panic("free_inode");
@@ -144,7 +142,6 @@ void free_inode(struct m_inode * inode)
 	if (clear_bit(inode->i_num&8191,bh->b_data))
 		panic("free_inode: bit already cleared");
 	bh->b_dirt = 1;
-	memset(inode,0,sizeof(*inode));
 }
 
 /*
@@ -179,6 +176,7 @@ struct m_inode * new_inode(int dev)
 	inode->i_dev=dev;
 	inode->i_dirt=1;
 	inode->i_num = j + i*8192;
+	insert_inode_hash(inode);
 	inode->i_mtime = inode->i_atime = inode->i_ctime = CURRENT_TIME;
 	return inode;
 }
@@ -37,7 +37,7 @@ extern int end;
 struct buffer_head * start_buffer = (struct buffer_head *) &end;
 struct buffer_head * hash_table[NR_HASH];
 static struct buffer_head * free_list;
-static struct task_struct * buffer_wait = NULL;
+static struct wait_queue * buffer_wait = NULL;
 int NR_BUFFERS = 0;
 
 static inline void wait_on_buffer(struct buffer_head * bh)
@@ -215,7 +215,7 @@ repeat:
 	 */
 	if (!tmp) {
 		printk(" [MEM] Warning: Cache Exhausted. Sleeping on free buffer...\n");
-		sleep_on(&buffer_wait);
+		sleep_on_exclusive(&buffer_wait);
 		printk(" [MEM] Recovery: Buffer freed. Retrying...\n");
 		goto repeat;
 	}
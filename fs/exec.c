@@ -15,6 +15,8 @@
 #include <linux/sched.h>
 #include <linux/kernel.h>
 #include <linux/mm.h>
+#include <linux/clocksource.h>
+#include <sys/timepage.h>
 #include <asm/segment.h>
 
 extern int sys_exit(int exit_code);
@@ -30,25 +32,11 @@ extern int sys_close(int fd);
  */
 #define MAX_ARG_PAGES 32
 
-inline void cp_block(const void * from,void * to, int size)
-{
-int d0,d1,d2;
-__asm__ __volatile("pushl $0x10\n\t"
-	"pushl $0x17\n\t"
-	"pop %%es\n\t"
-	"cld\n\t"
-	"rep\n\t"
-	"movsl\n\t"
-	"pop %%es"
-	:"=&c" (d0), "=&S" (d1), "=&D" (d2)
-	:"0" (size/4),"1" (from),"2" (to)
-	:"memory");
-}
-
 typedef struct
 {
 	unsigned long b_entry;
-	unsigned long b_size;				//file size
+	unsigned long b_code;				/* end of the executable segments */
+	unsigned long b_size;				/* end of the image, bss included */
 }bin_section;
 
 
@@ -163,13 +151,16 @@ static unsigned long change_ldt(unsigned long text_size,unsigned long * page)
 /* make sure fs points to the NEW data segment */
 /* fs가 새로운 데이터 세그먼트를 가리키도록 확인 */
 	__asm__("pushl $0x17\n\tpop %%fs"::);
-	data_base += data_limit;
+	map_time_page(data_base);
+	data_base += TIME_PAGE_ADDR;
 	for (i=MAX_ARG_PAGES-1 ; i>=0 ; i--) {
 		data_base -= PAGE_SIZE;
 		if (page[i])
 			put_page(page[i],data_base);
 	}
-	return data_limit;
+/* the argument pages end just below the time page */
+/* 인자 페이지는 시간 페이지 바로 아래에서 끝남 */
+	return TIME_PAGE_ADDR;
 }
 
 /*
@@ -274,49 +265,22 @@ struct buffer_head* read_file_block(struct m_inode * inode,int block_num)
 }
 
 
-/*  
- *  read an area into %fs:mem.
- *  영역을 %fs:mem으로 읽어옵니다.
+/*
+ * add_region: Records a segment for do_no_page() to read in on demand.
+ * Returns -1 if all regions are taken.
+ * add_region: do_no_page()가 요청 시 읽어 들일 세그먼트를 기록합니다. 모든
+ * 영역이 사용 중이면 -1을 반환합니다.
  */
-int copy_section(struct m_inode * inode,Elf32_Off from, Elf32_Addr dest,Elf32_Word size)
+static int add_region(Elf32_Off from, Elf32_Addr dest, Elf32_Word size)
 {
-	struct buffer_head * bh;
-	int block_num=from/BLOCK_SIZE;
-	int block_offset;			//only for 1st block
-	int cp_size;				
-
-	//read fist block / 첫 번째 블록 읽기
-	block_offset=from%BLOCK_SIZE;
-	bh=read_file_block(inode,block_num);
-	if (!bh) return -1;
-	cp_size=(size<BLOCK_SIZE-block_offset)?size:BLOCK_SIZE-block_offset;
-	//note we add 3 to size to get it aligned to word boundary
-	cp_block(bh->b_data+block_offset,(void*)dest,cp_size+3);
-	brelse(bh);
-	dest+=cp_size;
-	size-=cp_size;
-	block_num++;
-
-	//read others blocks / 다른 블록 읽기
-	while(size)
-	{
-		bh=read_file_block(inode,block_num);
-		if (!bh) return -1;
-		cp_size=(size<BLOCK_SIZE)?size:BLOCK_SIZE;
-		cp_block(bh->b_data,(void*)dest,cp_size+3);
-		block_num++;
-		size-=cp_size;
-		dest+=cp_size;
-		brelse(bh);
-	};
+	struct exec_region * r;
 
-	return 0;
-}
-
-inline int create_bss_section(Elf32_Addr dest,Elf32_Word size)
-{
-	while (size--)
-		put_fs_byte(0,(char *)dest++);
+	if (current->nr_regions == NR_EXEC_REGIONS)
+		return -1;
+	r = current->regions + current->nr_regions++;
+	r->addr = dest;
+	r->size = size;
+	r->offset = from;
 	return 0;
 }
 
@@ -330,76 +294,69 @@ inline int create_bss_section(Elf32_Addr dest,Elf32_Word size)
  * 오늘날 (bash 같은) 일부 프로그램을 a.out 형식으로 컴파일하기는 어렵습니다.
  * 그래서 이 버전의 linux 0.01은 elf 바이너리를 지원합니다.
  * 참고: 공유 라이브러리는 지원하지 않습니다!
+ *
+ * The image is described by the PT_LOAD program headers, which must lie
+ * in the first block of the file; section headers aren't looked at and
+ * may be stripped. Nothing is copied here: the file part of each segment,
+ * widened to whole pages, becomes a region that do_no_page() reads in on
+ * demand, and the rest up to p_memsz (the bss) is demand-zero.
+ * 이미지는 파일의 첫 블록에 있어야 하는 PT_LOAD 프로그램 헤더로 기술됩니다.
+ * 섹션 헤더는 보지 않으므로 제거되어 있어도 됩니다. 여기서는 아무것도
+ * 복사하지 않습니다: 각 세그먼트의 파일 부분을 페이지 단위로 넓혀
+ * do_no_page()가 요청 시 읽어 들이는 영역으로 만들고, p_memsz까지의
+ * 나머지(bss)는 요청 시 0으로 채웁니다.
  */
 int load_elf_binary(struct m_inode *inode, struct buffer_head* bh,
 					 bin_section* bs)
 {
-	Elf32_Ehdr ex;
-	Elf32_Shdr sect;
-	long nsect;
-	int lb=0;
-	struct buffer_head* bht=NULL;
-
-	ex = *((Elf32_Ehdr *) bh->b_data);	/* read exec-header / 실행 헤더 읽기 */
+	Elf32_Ehdr * ex = (Elf32_Ehdr *) bh->b_data;	/* exec-header / 실행 헤더 */
+	Elf32_Phdr * ph;
+	unsigned long delta, end;
+	int i;
 
 	/* check header / 헤더 확인 */
-	if (!is_valid_elf(&ex)) {
+	if (!is_valid_elf(ex))
 		return -1;
-	}
-
-	bs->b_entry=ex.e_entry;
-	nsect=ex.e_shnum;
-	bs->b_size=ex.e_ehsize+nsect*ex.e_shentsize;
-	
-	if (nsect<=1){
-		printk(" [ELF] Bad Nb of Sections: %d\n\r",nsect);
-		/* [ELF] 잘못된 섹션 수: %d */
+	if (ex->e_phentsize != sizeof(Elf32_Phdr) || !ex->e_phnum ||
+	    ex->e_phoff > BLOCK_SIZE ||
+	    ex->e_phnum > (BLOCK_SIZE - ex->e_phoff) / sizeof(Elf32_Phdr)) {
+		printk(" [ELF] Bad Program Header Table\n\r");
+		/* [ELF] 잘못된 프로그램 헤더 테이블 */
 		return -1;
 	}
-	
-	while(nsect--){
-	
-		/* load block where is our table section / 테이블 섹션이 있는 블록 로드 */
-		if ((ex.e_shoff + nsect * ex.e_shentsize)/BLOCK_SIZE != lb)
-		{
-			printk("");	// gcc  bug : removing this line = gcc not happy !!!
-			lb = (ex.e_shoff + nsect * ex.e_shentsize)/BLOCK_SIZE;
-			if (bht) brelse(bht);
-			bht=read_file_block(inode,lb);
-			if (!bht) return -1;
-		}
 
-		/* copy this section fo %fs:mem / 이 섹션을 %fs:mem으로 복사 */
-		sect=*((Elf32_Shdr *)(bht->b_data + (ex.e_shoff + 
-				nsect * ex.e_shentsize)%BLOCK_SIZE ));
-	
-		if (!sect.sh_size || !sect.sh_addr) continue;
-		
-		switch(sect.sh_type)
-		{
-			case SHT_PROGBITS:
-				if (copy_section(inode,sect.sh_offset,sect.sh_addr,
-					sect.sh_size))
-				{
-					if (bht) brelse(bht);
-					return -1;
-				}
-				break;
-			
-			case SHT_NOBITS:	  
-				create_bss_section(sect.sh_addr,sect.sh_size);
-				break;
-
-			default:
-			continue;	  
+	bs->b_entry = ex->e_entry;
+	bs->b_code = bs->b_size = 0;
+	current->nr_regions = 0;
+	ph = (Elf32_Phdr *) (bh->b_data + ex->e_phoff);
+	for (i=0 ; i<ex->e_phnum ; i++,ph++) {
+		if (ph->p_type != PT_LOAD || !ph->p_memsz)
+			continue;
+		delta = ph->p_vaddr & 0xfff;
+		end = ph->p_vaddr + ph->p_memsz;
+		if (ph->p_filesz > ph->p_memsz || (ph->p_offset & 0xfff) != delta ||
+		    end < ph->p_vaddr ||
+		    end > TIME_PAGE_ADDR - MAX_ARG_PAGES*PAGE_SIZE) {
+			printk(" [ELF] Bad Segment at %p\n\r",ph->p_vaddr);
+			/* [ELF] 잘못된 세그먼트 */
+			return -1;
 		}
-
-		/* find binary size / 바이너리 크기 찾기 */
-		if (bs->b_size<sect.sh_addr + sect.sh_size)
-			bs->b_size=sect.sh_addr + sect.sh_size;	
-	};
-
-	if (bht) brelse(bht);
+		if (ph->p_filesz && add_region(ph->p_offset - delta,
+		    ph->p_vaddr - delta, ph->p_filesz + delta)) {
+			printk(" [ELF] Too Many Segments\n\r");
+			/* [ELF] 세그먼트가 너무 많음 */
+			return -1;
+		}
+		if ((ph->p_flags & PF_X) && bs->b_code < end)
+			bs->b_code = end;
+		if (bs->b_size < end)
+			bs->b_size = end;
+	}
+	if (!bs->b_code || bs->b_entry >= bs->b_code) {
+		printk(" [ELF] No Code Segment\n\r");
+		/* [ELF] 코드 세그먼트 없음 */
+		return -1;
+	}
 	return 0;
 }
 
@@ -468,9 +425,13 @@ int do_execve(unsigned long * eip,long tmp,char * filename,
 
 	free_page_tables(get_base(current->ldt[1]),get_limit(0x0f));
 	free_page_tables(get_base(current->ldt[2]),get_limit(0x17));
-	
+/* from here on the image is paged in from the inode / 여기부터 이미지는 아이노드에서 페이지 단위로 읽힘 */
+	iput(current->executable);
+	current->executable = inode;
+
 	if (load_elf_binary(inode,bh,&bs)){
 		brelse(bh);
+		current->executable = NULL;
 		iput(inode);
 		return -EACCES;
 	}
@@ -479,18 +440,13 @@ int do_execve(unsigned long * eip,long tmp,char * filename,
 	if (last_task_used_math == current)
 		last_task_used_math = NULL;
 	current->used_math = 0;
-	p += change_ldt(bs.b_size,page)-MAX_ARG_PAGES*PAGE_SIZE;
+	p += change_ldt(bs.b_code,page)-MAX_ARG_PAGES*PAGE_SIZE;
 	p = (unsigned long) create_tables((char *)p,argc,envc);
 	current->brk = bs.b_size;
 	current->end_data = bs.b_size;
-	current->end_code = bs.b_size;
+	current->end_code = bs.b_code;
 	current->start_stack = p & 0xfffff000;
-	iput(inode);
 
-	i = bs.b_size;
-	while (i&0xfff)
-		put_fs_byte(0,(char *) (i++));
-	
 	eip[0] = bs.b_entry;		/* eip, magic happens :-) / eip, 마법이 일어납니다 :-) */
 	eip[3] = p;					/* stack pointer / 스택 포인터 */
 
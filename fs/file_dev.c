@@ -1,5 +1,6 @@
 #include <errno.h>
 #include <fcntl.h>
+#include <string.h>
 
 #include <linux/sched.h>
 #include <linux/kernel.h>
@@ -8,7 +9,16 @@
 #define MIN(a,b) (((a)<(b))?(a):(b))
 #define MAX(a,b) (((a)>(b))?(a):(b))
 
-int file_read(struct m_inode * inode, struct file * filp, char * buf, int count)
+/*
+ * _file_read: Common body of file_read() and file_splice_read(). When
+ * 'kernel' is set, 'buf' is a kernel address (e.g. a pipe ring used by
+ * splice) and is filled with memcpy instead of put_fs_byte.
+ * _file_read: file_read()와 file_splice_read()의 공통 본체입니다. 'kernel'이
+ * 설정되면 'buf'는 커널 주소(예: splice가 사용하는 파이프 링)이며
+ * put_fs_byte 대신 memcpy로 채워집니다.
+ */
+static int _file_read(struct m_inode * inode, struct file * filp,
+		char * buf, int count, int kernel)
 {
 	int left,chars,nr;
 	struct buffer_head * bh;
@@ -27,9 +37,16 @@ int file_read(struct m_inode * inode, struct file * filp, char * buf, int count)
 		left -= chars;
 		if (bh) {
 			char * p = nr + bh->b_data;
-			while (chars-->0)
-				put_fs_byte(*(p++),buf++);
+			if (kernel) {
+				memcpy(buf,p,chars);
+				buf += chars;
+			} else
+				while (chars-->0)
+					put_fs_byte(*(p++),buf++);
 			brelse(bh);
+		} else if (kernel) {
+			memset(buf,0,chars);
+			buf += chars;
 		} else {
 			while (chars-->0)
 				put_fs_byte(0,buf++);
@@ -39,7 +56,23 @@ int file_read(struct m_inode * inode, struct file * filp, char * buf, int count)
 	return (count-left)?(count-left):-ERROR;
 }
 
-int file_write(struct m_inode * inode, struct file * filp, char * buf, int count)
+int file_read(struct m_inode * inode, struct file * filp, char * buf, int count)
+{
+	return _file_read(inode,filp,buf,count,0);
+}
+
+int file_splice_read(struct m_inode * inode, struct file * filp,
+		char * buf, int count)
+{
+	return _file_read(inode,filp,buf,count,1);
+}
+
+/*
+ * _file_write: Common body of file_write() and file_splice_write().
+ * _file_write: file_write()와 file_splice_write()의 공통 본체입니다.
+ */
+static int _file_write(struct m_inode * inode, struct file * filp,
+		char * buf, int count, int kernel)
 {
 	off_t pos;
 	int block,c;
@@ -71,8 +104,12 @@ int file_write(struct m_inode * inode, struct file * filp, char * buf, int count
 			inode->i_dirt = 1;
 		}
 		i += c;
-		while (c-->0)
-			*(p++) = get_fs_byte(buf++);
+		if (kernel) {
+			memcpy(p,buf,c);
+			buf += c;
+		} else
+			while (c-->0)
+				*(p++) = get_fs_byte(buf++);
 		brelse(bh);
 	}
 	inode->i_mtime = CURRENT_TIME;
@@ -82,3 +119,14 @@ int file_write(struct m_inode * inode, struct file * filp, char * buf, int count
 	}
 	return (i?i:-1);
 }
+
+int file_write(struct m_inode * inode, struct file * filp, char * buf, int count)
+{
+	return _file_write(inode,filp,buf,count,0);
+}
+
+int file_splice_write(struct m_inode * inode, struct file * filp,
+		char * buf, int count)
+{
+	return _file_write(inode,filp,buf,count,1);
+}
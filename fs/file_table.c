@@ -1,3 +1,58 @@
+/*
+ *  linux/fs/file_table.c
+ *
+ *  (C) 1991 Linus Torvalds
+ *  Modified by Rheehose (Rhee Creative) 2008-2026
+ */
+
+/*
+ * Open files come from a slab cache instead of a fixed table: allocation
+ * no longer scans for a free slot, and the number of open files is bounded
+ * by memory only. Free entries are all zero.
+ * 열린 파일은 고정 테이블 대신 슬랩 캐시에서 옵니다: 할당 시 더 이상 빈
+ * 슬롯을 검색하지 않으며, 열린 파일 수는 메모리에만 제한됩니다. 여유 항목은
+ * 모두 0입니다.
+ */
+
+#include <string.h>
+
 #include <linux/fs.h>
+#include <linux/kernel.h>
+#include <linux/slab.h>
+
+static struct kmem_cache * filp_cachep;
+
+static void filp_ctor(void * obj)
+{
+	memset(obj,0,sizeof(struct file));
+}
+
+void file_table_init(void)
+{
+	if (!(filp_cachep = kmem_cache_create("filp", sizeof(struct file),
+	    filp_ctor)))
+		panic("file_table_init: out of memory");
+}
+
+/*
+ * get_empty_filp: A new file with f_count 1, NULL if out of memory.
+ * get_empty_filp: f_count가 1인 새 파일이며, 메모리가 부족하면 NULL입니다.
+ */
+struct file * get_empty_filp(void)
+{
+	struct file * f;
+
+	if ((f = kmem_cache_alloc(filp_cachep)))
+		f->f_count = 1;
+	return f;
+}
 
-struct file file_table[NR_FILE];
+/*
+ * put_filp: Frees a file whose last reference is gone.
+ * put_filp: 마지막 참조가 사라진 파일을 해제합니다.
+ */
+void put_filp(struct file * f)
+{
+	memset(f,0,sizeof(*f));
+	kmem_cache_free(filp_cachep, f);
+}
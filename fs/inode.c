@@ -10,12 +10,35 @@
 #include <linux/sched.h>
 #include <linux/kernel.h>
 #include <linux/mm.h>
+#include <linux/slab.h>
 #include <asm/system.h>
 
-struct m_inode inode_table[NR_INODE]={{0,},};
+/*
+ * In-core inodes come from a slab cache, so their number is bounded by
+ * memory only. All of them are on 'inode_list' for sync_inodes(); those
+ * of a device are also hashed by (dev,num) for iget(). When the last
+ * user of a device inode goes away it stays cached, clean, on the unused
+ * LRU list, so iget() finds it again without a disk read. The slab
+ * allocator shrinks that list from its old end when memory runs out, see
+ * kmem_cache_reap().
+ * 메모리 내 아이노드는 슬랩 캐시에서 오므로, 그 수는 메모리에만 제한됩니다.
+ * 모두 sync_inodes()를 위해 'inode_list'에 있으며, 장치의 아이노드는
+ * iget()을 위해 (dev,num)으로도 해시됩니다. 장치 아이노드의 마지막 사용자가
+ * 사라지면 깨끗한 상태로 미사용 LRU 리스트에 캐시되어 남으므로, iget()은
+ * 디스크를 읽지 않고 다시 찾습니다. 메모리가 바닥나면 슬랩 할당기가 그
+ * 리스트를 오래된 쪽부터 줄이며, kmem_cache_reap()을 참조하세요.
+ */
+#define NR_IHASH 131
+#define ihashfn(dev,nr) (((unsigned)((dev)^(nr)))%NR_IHASH)
+
+static struct kmem_cache * inode_cachep;
+static struct m_inode * inode_list = NULL;
+static struct m_inode * inode_hash[NR_IHASH];
+static struct m_inode * lru_head = NULL, * lru_tail = NULL;
 
 static void read_inode(struct m_inode * inode);
 static void write_inode(struct m_inode * inode);
+static void destroy_inode(struct m_inode * inode);
 
 /*
  * wait_on_inode: Suspends process execution until the specified inode is unlocked.
@@ -37,7 +60,7 @@ static inline void lock_inode(struct m_inode * inode)
 {
 	cli();
 	while (inode->i_lock)
-		sleep_on(&inode->i_wait);
+		sleep_on_exclusive(&inode->i_wait);
 	inode->i_lock=1;
 	sti();
 }
@@ -52,20 +75,91 @@ static inline void unlock_inode(struct m_inode * inode)
 	wake_up(&inode->i_wait);
 }
 
+/*
+ * The unused LRU list. An in-core inode is on it exactly while its
+ * i_count is zero.
+ * 미사용 LRU 리스트. 메모리 내 아이노드는 i_count가 0인 동안에만 여기에
+ * 있습니다.
+ */
+static void lru_add(struct m_inode * inode)
+{
+	inode->i_lru_prev = NULL;
+	if ((inode->i_lru_next = lru_head))
+		lru_head->i_lru_prev = inode;
+	else
+		lru_tail = inode;
+	lru_head = inode;
+}
+
+static void lru_del(struct m_inode * inode)
+{
+	if (inode->i_lru_prev)
+		inode->i_lru_prev->i_lru_next = inode->i_lru_next;
+	else
+		lru_head = inode->i_lru_next;
+	if (inode->i_lru_next)
+		inode->i_lru_next->i_lru_prev = inode->i_lru_prev;
+	else
+		lru_tail = inode->i_lru_prev;
+}
+
+/*
+ * grab_inode: Takes a reference, off the LRU list if it was unused.
+ * grab_inode: 참조를 하나 얻으며, 미사용이었다면 LRU 리스트에서 뺍니다.
+ */
+static inline void grab_inode(struct m_inode * inode)
+{
+	if (!inode->i_count++)
+		lru_del(inode);
+}
+
+/*
+ * shrink_inode_cache: The inode cache's shrinker. Frees up to 'nr' unused
+ * inodes, least recently used first, and returns how many it freed. They
+ * are clean and unlocked, so this never sleeps.
+ * shrink_inode_cache: 아이노드 캐시의 shrink 함수. 사용하지 않는
+ * 아이노드를 가장 오래전에 쓰인 것부터 최대 'nr'개 해제하고, 해제한 수를
+ * 반환합니다. 이들은 깨끗하고 잠겨 있지 않으므로 절대 잠들지 않습니다.
+ */
+static int shrink_inode_cache(int nr)
+{
+	struct m_inode * inode;
+	int freed = 0;
+
+	while (freed < nr && (inode = lru_tail)) {
+		lru_del(inode);
+		destroy_inode(inode);
+		freed++;
+	}
+	return freed;
+}
+
 /*
  * sync_inodes: Synchronizes all dirty inodes in the inode table to the disk.
  * sync_inodes: 아이노드 테이블의 모든 변경된(dirty) 아이노드를 디스크에 동기화합니다.
  */
 void sync_inodes(void)
 {
-	int i;
-	struct m_inode * inode;
+	struct m_inode * inode, * next;
 
-	inode = 0+inode_table;
-	for(i=0 ; i<NR_INODE ; i++,inode++) {
-		wait_on_inode(inode);
-		if (inode->i_dirt && !inode->i_pipe)
-			write_inode(inode);
+	for (inode = inode_list ; inode ; inode = next) {
+		if (!inode->i_dirt || inode->i_pipe) {
+			next = inode->i_next;
+			continue;
+		}
+		/* pinned, it stays on the list while write_inode() sleeps */
+		/* 고정되어 있으므로 write_inode()가 잠든 동안 리스트에 남음 */
+		grab_inode(inode);
+		write_inode(inode);
+		next = inode->i_next;
+		if (inode->i_count > 1) {
+			inode->i_count--;
+			continue;
+		}
+		/* we were the last user: iput() may sleep, start over */
+		/* 마지막 사용자였음: iput()이 잠들 수 있으므로 처음부터 */
+		iput(inode);
+		next = inode_list;
 	}
 }
 
@@ -167,19 +261,19 @@ void iput(struct m_inode * inode)
 		if (--inode->i_count)
 			return;
 		free_page(inode->i_size);
-		inode->i_count=0;
-		inode->i_dirt=0;
-		inode->i_pipe=0;
+		destroy_inode(inode);
 		return;
 	}
 	if (!inode->i_dev || inode->i_count>1) {
-		inode->i_count--;
+		if (!--inode->i_count)
+			destroy_inode(inode);
 		return;
 	}
 repeat:
 	if (!inode->i_nlinks) {
 		truncate(inode);
 		free_inode(inode);
+		destroy_inode(inode);
 		return;
 	}
 	if (inode->i_dirt) {
@@ -187,50 +281,81 @@ repeat:
 		wait_on_inode(inode);
 		goto repeat;
 	}
-	inode->i_count--;
+	if (!--inode->i_count)
+		lru_add(inode);		/* keep it cached / 캐시에 유지 */
 	return;
 }
 
-static volatile int last_allocated_inode = 0;
+/* The slab constructor: free inodes are all zero / 슬랩 생성자: 여유 아이노드는 모두 0 */
+static void inode_ctor(void * obj)
+{
+	memset(obj,0,sizeof(struct m_inode));
+}
+
+void inode_init(void)
+{
+	if (!(inode_cachep = kmem_cache_create("inode", sizeof(struct m_inode),
+	    inode_ctor)))
+		panic("inode_init: out of memory");
+	inode_cachep->shrink = shrink_inode_cache;
+}
+
+/*
+ * insert_inode_hash: Makes an inode with i_dev and i_num set findable by
+ * iget().
+ * insert_inode_hash: i_dev와 i_num이 설정된 아이노드를 iget()으로 찾을 수
+ * 있게 합니다.
+ */
+void insert_inode_hash(struct m_inode * inode)
+{
+	struct m_inode ** head = inode_hash + ihashfn(inode->i_dev,inode->i_num);
+
+	inode->i_hash_prev = NULL;
+	if ((inode->i_hash_next = *head))
+		inode->i_hash_next->i_hash_prev = inode;
+	*head = inode;
+}
 
 /*
- * get_empty_inode: Finds and returns an unused inode from the inode table.
- * get_empty_inode: 아이노드 테이블에서 사용되지 않는 아이노드를 찾아 반환합니다.
+ * destroy_inode: Unlinks an inode nobody uses any more and gives it back
+ * to the cache, zeroed as the constructor left it.
+ * destroy_inode: 더 이상 아무도 쓰지 않는 아이노드의 연결을 끊고, 생성자가
+ * 남긴 대로 0으로 채워 캐시에 돌려줍니다.
+ */
+static void destroy_inode(struct m_inode * inode)
+{
+	if (inode->i_hash_prev)
+		inode->i_hash_prev->i_hash_next = inode->i_hash_next;
+	else if (inode_hash[ihashfn(inode->i_dev,inode->i_num)] == inode)
+		inode_hash[ihashfn(inode->i_dev,inode->i_num)] = inode->i_hash_next;
+	if (inode->i_hash_next)
+		inode->i_hash_next->i_hash_prev = inode->i_hash_prev;
+	if (inode->i_prev)
+		inode->i_prev->i_next = inode->i_next;
+	else
+		inode_list = inode->i_next;
+	if (inode->i_next)
+		inode->i_next->i_prev = inode->i_prev;
+	memset(inode,0,sizeof(*inode));
+	kmem_cache_free(inode_cachep, inode);
+}
+
+/*
+ * get_empty_inode: Allocates a new in-core inode, NULL if out of memory.
+ * get_empty_inode: 새 메모리 내 아이노드를 할당하며, 메모리가 부족하면
+ * NULL입니다.
  */
 struct m_inode * get_empty_inode(void)
 {
 	struct m_inode * inode;
-	int inr;
-
-	while (1) {
-		inode = NULL;
-		inr = last_allocated_inode;
-		do {
-			if (!inode_table[inr].i_count) {
-				inode = inr + inode_table;
-				break;
-			}
-			inr++;
-			if (inr>=NR_INODE)
-				inr=0;
-		} while (inr != last_allocated_inode);
-		if (!inode) {
-			for (inr=0 ; inr<NR_INODE ; inr++)
-				printk("%04x: %6d\t",inode_table[inr].i_dev,
-					inode_table[inr].i_num);
-			panic("No free inodes in mem");
-		}
-		last_allocated_inode = inr;
-		wait_on_inode(inode);
-		while (inode->i_dirt) {
-			write_inode(inode);
-			wait_on_inode(inode);
-		}
-		if (!inode->i_count)
-			break;
-	}
-	memset(inode,0,sizeof(*inode));
+
+	if (!(inode = kmem_cache_alloc(inode_cachep)))
+		return NULL;
 	inode->i_count = 1;
+	inode->i_prev = NULL;
+	if ((inode->i_next = inode_list))
+		inode_list->i_prev = inode;
+	inode_list = inode;
 	return inode;
 }
 
@@ -244,8 +369,8 @@ struct m_inode * get_pipe_inode(void)
 
 	if (!(inode = get_empty_inode()))
 		return NULL;
-	if (!(inode->i_size=get_free_page())) {
-		inode->i_count = 0;
+	if (!(inode->i_size=__get_free_page())) {
+		destroy_inode(inode);
 		return NULL;
 	}
 	inode->i_count = 2;	/* sum of readers/writers / 읽기/쓰기 수의 합 */
@@ -256,36 +381,32 @@ struct m_inode * get_pipe_inode(void)
 
 /*
  * iget: Retrieves an inode with the specified device and inode number.
+ * Allocating never sleeps, so nobody can bring the same inode in between
+ * the hash lookup and insert_inode_hash(). Running out of memory even
+ * after the caches have been shrunk is fatal, as callers can't cope.
  * iget: 지정된 장치 및 아이노드 번호를 가진 아이노드를 검색합니다.
+ * 할당은 절대 잠들지 않으므로, 해시 조회와 insert_inode_hash() 사이에 누구도
+ * 같은 아이노드를 들여올 수 없습니다. 캐시를 줄인 뒤에도 메모리가 부족하면
+ * 호출자가 대처할 수 없으므로 치명적입니다.
  */
 struct m_inode * iget(int dev,int nr)
 {
-	struct m_inode * inode, * empty;
+	struct m_inode * inode;
 
 	if (!dev)
 		panic("iget with dev==0");
-	empty = get_empty_inode();
-	inode = inode_table;
-	while (inode < NR_INODE+inode_table) {
-		if (inode->i_dev != dev || inode->i_num != nr) {
-			inode++;
+	for (inode = inode_hash[ihashfn(dev,nr)] ; inode ; inode = inode->i_hash_next) {
+		if (inode->i_dev != dev || inode->i_num != nr)
 			continue;
-		}
+		grab_inode(inode);	/* holds it while we wait */
 		wait_on_inode(inode);
-		if (inode->i_dev != dev || inode->i_num != nr) {
-			inode = inode_table;
-			continue;
-		}
-		inode->i_count++;
-		if (empty)
-			iput(empty);
 		return inode;
 	}
-	if (!empty)
-		return (NULL);
-	inode=empty;
+	if (!(inode = get_empty_inode()))
+		panic("iget: no memory for inodes");
 	inode->i_dev = dev;
 	inode->i_num = nr;
+	insert_inode_hash(inode);
 	read_inode(inode);
 	return inode;
 }
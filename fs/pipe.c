@@ -6,11 +6,31 @@
  */
 
 #include <signal.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
 
 #include <linux/sched.h>
 #include <linux/mm.h>	/* for get_free_page */
 #include <asm/segment.h>
 
+extern int file_splice_read(struct m_inode * inode, struct file * filp,
+		char * buf, int count);
+extern int file_splice_write(struct m_inode * inode, struct file * filp,
+		char * buf, int count);
+
+#define MIN(a,b) (((a)<(b))?(a):(b))
+
+/*
+ * Ring helpers for splice/tee. PIPE_FREE is the room left in the ring,
+ * PIPE_ADD advances a head/tail index by 'n' bytes with wrap-around.
+ * splice/tee용 링 헬퍼. PIPE_FREE는 링의 남은 공간이며, PIPE_ADD는
+ * head/tail 인덱스를 'n' 바이트만큼 순환하며 전진시킵니다.
+ */
+#define PIPE_FREE(inode) ((PAGE_SIZE-1)-PIPE_SIZE(inode))
+#define PIPE_ADD(idx,n) ((idx) = ((idx)+(n)) & (PAGE_SIZE-1))
+#define PIPE_BUF(inode) ((char *) (inode).i_size)
+
 /*
  * read_pipe: Reads data from a pipe.
  * read_pipe: 파이프에서 데이터를 읽어옵니다.
@@ -75,14 +95,12 @@ int sys_pipe(unsigned long * fildes)
 	int fd[2];
 	int i,j;
 
-	j=0;
-	for(i=0;j<2 && i<NR_FILE;i++)
-		if (!file_table[i].f_count)
-			(f[j++]=i+file_table)->f_count++;
-	if (j==1)
-		f[0]->f_count=0;
-	if (j<2)
+	if (!(f[0]=get_empty_filp()))
 		return -1;
+	if (!(f[1]=get_empty_filp())) {
+		put_filp(f[0]);
+		return -1;
+	}
 	j=0;
 	for(i=0;j<2 && i<NR_OPEN;i++)
 		if (!current->filp[i]) {
@@ -92,13 +110,15 @@ int sys_pipe(unsigned long * fildes)
 	if (j==1)
 		current->filp[fd[0]]=NULL;
 	if (j<2) {
-		f[0]->f_count=f[1]->f_count=0;
+		put_filp(f[0]);
+		put_filp(f[1]);
 		return -1;
 	}
 	if (!(inode=get_pipe_inode())) {
 		current->filp[fd[0]] =
 			current->filp[fd[1]] = NULL;
-		f[0]->f_count = f[1]->f_count = 0;
+		put_filp(f[0]);
+		put_filp(f[1]);
 		return -1;
 	}
 	f[0]->f_inode = f[1]->f_inode = inode;
@@ -113,3 +133,223 @@ int sys_pipe(unsigned long * fildes)
 	put_fs_long(fd[1],1+fildes);
 	return 0;
 }
+
+/*
+ * pipe_wait_data: Sleeps until the pipe holds data. Returns 0 if the
+ * pipe is empty and there are no writers left (end of file).
+ * pipe_wait_data: 파이프에 데이터가 생길 때까지 대기합니다. 파이프가 비어
+ * 있고 남은 쓰기 프로세스가 없으면(파일 끝) 0을 반환합니다.
+ */
+static int pipe_wait_data(struct m_inode * inode)
+{
+	while (PIPE_EMPTY(*inode)) {
+		wake_up(&inode->i_wait);
+		if (inode->i_count != 2)
+			return 0;
+		sleep_on(&inode->i_wait);
+	}
+	return 1;
+}
+
+/*
+ * pipe_wait_space: Sleeps until the pipe has room. Returns 0 (and raises
+ * SIGPIPE, as write_pipe does) if there are no readers left.
+ * pipe_wait_space: 파이프에 공간이 생길 때까지 대기합니다. 남은 읽기
+ * 프로세스가 없으면 (write_pipe처럼 SIGPIPE를 발생시키고) 0을 반환합니다.
+ */
+static int pipe_wait_space(struct m_inode * inode)
+{
+	do {
+		wake_up(&inode->i_wait);
+		if (inode->i_count != 2) {
+			current->signal |= (1<<(SIGPIPE-1));
+			return 0;
+		}
+		if (!PIPE_FULL(*inode))
+			return 1;
+		sleep_on(&inode->i_wait);
+	} while (1);
+}
+
+/*
+ * pipe_copy: Copies up to 'len' buffered bytes from pipe 'in' into pipe
+ * 'out' with memcpy, never touching user space. The data is consumed
+ * from 'in' only if 'consume' is set (splice), otherwise it stays (tee).
+ * pipe_copy: 파이프 'in'에 버퍼링된 최대 'len' 바이트를 memcpy로 파이프
+ * 'out'에 복사하며 사용자 공간을 전혀 거치지 않습니다. 'consume'이 설정된
+ * 경우(splice)에만 'in'에서 데이터가 소비되고, 그렇지 않으면(tee) 남습니다.
+ */
+static int pipe_copy(struct m_inode * in, struct m_inode * out, int len,
+		int consume)
+{
+	long tail = PIPE_TAIL(*in);
+	int avail = PIPE_SIZE(*in);
+	int chars, done = 0;
+
+	while (len > 0 && avail > 0 && !PIPE_FULL(*out)) {
+		chars = MIN(len, avail);
+		chars = MIN(chars, PAGE_SIZE - tail);
+		chars = MIN(chars, PIPE_FREE(*out));
+		chars = MIN(chars, PAGE_SIZE - PIPE_HEAD(*out));
+		memcpy(PIPE_BUF(*out) + PIPE_HEAD(*out),
+			PIPE_BUF(*in) + tail, chars);
+		PIPE_ADD(PIPE_HEAD(*out), chars);
+		PIPE_ADD(tail, chars);
+		avail -= chars;
+		len -= chars;
+		done += chars;
+	}
+	if (consume)
+		PIPE_TAIL(*in) = tail;
+	return done;
+}
+
+/*
+ * splice_pipe_to_file: Drains buffered pipe data straight into the
+ * buffer cache blocks of a regular file.
+ * splice_pipe_to_file: 버퍼링된 파이프 데이터를 일반 파일의 버퍼 캐시
+ * 블록으로 곧바로 배출합니다.
+ */
+static int splice_pipe_to_file(struct m_inode * in, struct file * out,
+		int len)
+{
+	int chars, written, done = 0;
+
+	if (!pipe_wait_data(in))
+		return 0;
+	while (len > 0 && !PIPE_EMPTY(*in)) {
+		chars = MIN(len, PIPE_SIZE(*in));
+		chars = MIN(chars, PAGE_SIZE - PIPE_TAIL(*in));
+		written = file_splice_write(out->f_inode, out,
+			PIPE_BUF(*in) + PIPE_TAIL(*in), chars);
+		if (written <= 0)
+			break;
+		PIPE_ADD(PIPE_TAIL(*in), written);
+		len -= written;
+		done += written;
+		if (written < chars)
+			break;
+	}
+	wake_up(&in->i_wait);
+	return done ? done : -ENOSPC;
+}
+
+/*
+ * splice_file_to_pipe: Reads regular-file blocks directly into the free
+ * part of the pipe ring.
+ * splice_file_to_pipe: 일반 파일 블록을 파이프 링의 빈 부분으로 직접
+ * 읽어 들입니다.
+ */
+static int splice_file_to_pipe(struct file * in, struct m_inode * out,
+		int len)
+{
+	struct m_inode * inode = in->f_inode;
+	int chars, got, done = 0;
+
+	if (len > inode->i_size - in->f_pos)
+		len = inode->i_size - in->f_pos;
+	if (len <= 0)
+		return 0;
+	if (!pipe_wait_space(out))
+		return -EPIPE;
+	while (len > 0 && !PIPE_FULL(*out)) {
+		chars = MIN(len, PIPE_FREE(*out));
+		chars = MIN(chars, PAGE_SIZE - PIPE_HEAD(*out));
+		got = file_splice_read(inode, in,
+			PIPE_BUF(*out) + PIPE_HEAD(*out), chars);
+		if (got <= 0)
+			break;
+		PIPE_ADD(PIPE_HEAD(*out), got);
+		len -= got;
+		done += got;
+	}
+	wake_up(&out->i_wait);
+	return done;
+}
+
+/*
+ * splice_pipe_to_pipe: Moves buffered data from one pipe ring to another.
+ * splice_pipe_to_pipe: 버퍼링된 데이터를 한 파이프 링에서 다른 링으로 옮깁니다.
+ */
+static int splice_pipe_to_pipe(struct m_inode * in, struct m_inode * out,
+		int len, int consume)
+{
+	int done;
+
+	if (!pipe_wait_data(in))
+		return 0;
+	if (!pipe_wait_space(out))
+		return -EPIPE;
+	done = pipe_copy(in, out, len, consume);
+	if (consume)
+		wake_up(&in->i_wait);
+	wake_up(&out->i_wait);
+	return done;
+}
+
+/*
+ * sys_splice: Moves up to 'len' bytes between a pipe and a regular file,
+ * or between two pipes, without copying through user space. At least one
+ * side must be a pipe; file offsets are taken from (and advance) the
+ * open file, as with read()/write(). Like read_pipe, it blocks only until
+ * some data can be moved and returns the number of bytes moved.
+ * sys_splice: 파이프와 일반 파일 사이, 또는 두 파이프 사이에서 최대 'len'
+ * 바이트를 사용자 공간을 거치지 않고 옮깁니다. 최소 한쪽은 파이프여야 하며,
+ * 파일 오프셋은 read()/write()처럼 열린 파일의 것을 사용(및 전진)합니다.
+ * read_pipe처럼 일부 데이터를 옮길 수 있을 때까지만 대기하며, 옮긴 바이트
+ * 수를 반환합니다.
+ */
+int sys_splice(unsigned int fd_in, unsigned int fd_out, int len)
+{
+	struct file * in, * out;
+	struct m_inode * ii, * oi;
+
+	if (fd_in >= NR_OPEN || fd_out >= NR_OPEN ||
+	    !(in=current->filp[fd_in]) || !(out=current->filp[fd_out]))
+		return -EBADF;
+	if (len < 0)
+		return -EINVAL;
+	if (!len)
+		return 0;
+	ii = in->f_inode;
+	oi = out->f_inode;
+	if ((ii->i_pipe && !(in->f_mode&1)) || (oi->i_pipe && !(out->f_mode&2)))
+		return -EBADF;
+	if (ii->i_pipe && oi->i_pipe) {
+		if (ii == oi)
+			return -EINVAL;
+		return splice_pipe_to_pipe(ii,oi,len,1);
+	}
+	if (ii->i_pipe && S_ISREG(oi->i_mode))
+		return splice_pipe_to_file(ii,out,len);
+	if (S_ISREG(ii->i_mode) && oi->i_pipe)
+		return splice_file_to_pipe(in,oi,len);
+	return -EINVAL;
+}
+
+/*
+ * sys_tee: Duplicates up to 'len' bytes buffered in pipe 'fd_in' into pipe
+ * 'fd_out' without consuming them, so the same data can still be read or
+ * spliced from 'fd_in' afterwards.
+ * sys_tee: 파이프 'fd_in'에 버퍼링된 최대 'len' 바이트를 소비하지 않고 파이프
+ * 'fd_out'에 복제하므로, 이후에도 같은 데이터를 'fd_in'에서 읽거나 splice할
+ * 수 있습니다.
+ */
+int sys_tee(unsigned int fd_in, unsigned int fd_out, int len)
+{
+	struct file * in, * out;
+
+	if (fd_in >= NR_OPEN || fd_out >= NR_OPEN ||
+	    !(in=current->filp[fd_in]) || !(out=current->filp[fd_out]))
+		return -EBADF;
+	if (len < 0)
+		return -EINVAL;
+	if (!len)
+		return 0;
+	if (!in->f_inode->i_pipe || !out->f_inode->i_pipe ||
+	    in->f_inode == out->f_inode)
+		return -EINVAL;
+	if (!(in->f_mode&1) || !(out->f_mode&2))
+		return -EBADF;
+	return splice_pipe_to_pipe(in->f_inode,out->f_inode,len,0);
+}
@@ -11,7 +11,8 @@ static int cp_stat(struct m_inode * inode, struct stat * statbuf)
 	struct stat tmp;
 	int i;
 
-	verify_area(statbuf,sizeof (* statbuf));
+	if (verify_area(statbuf,sizeof (* statbuf)))
+		return -EFAULT;
 	tmp.st_dev = inode->i_dev;
 	tmp.st_ino = inode->i_num;
 	tmp.st_mode = inode->i_mode;
@@ -61,7 +62,8 @@ static int cp_stat64(struct m_inode * inode, struct stat64 * statbuf)
 	struct stat64 tmp;
 	int i;
 
-	verify_area(statbuf,sizeof (* statbuf));
+	if (verify_area(statbuf,sizeof (* statbuf)))
+		return -EFAULT;
 	tmp.st_dev = inode->i_dev;
 	tmp.st_ino = inode->i_num;
 	tmp.st_mode = inode->i_mode;
@@ -91,8 +91,6 @@ void mount_root(void)
 
 	if (32 != sizeof (struct d_inode))
 		panic("bad i-node size");
-	for(i=0;i<NR_FILE;i++)
-		file_table[i].f_count=0;
 	for(p = &super_block[0] ; p < &super_block[NR_SUPER] ; p++)
 		p->s_dev = 0;
 	if (!(p=do_mount(ROOT_DEV)))
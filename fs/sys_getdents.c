@@ -106,7 +106,8 @@ int sys_getdents(unsigned int fd, struct dirent *dirp, unsigned int count)
 	    !(inode = file->f_inode))
 		return -EBADF;
 
-	verify_area(dirp, sizeof (*dirp));
+	if (verify_area(dirp, sizeof (*dirp)))
+		return -EFAULT;
 	return minix_getdents(inode,file,dirp,count);
 }
 
@@ -118,7 +119,8 @@ int sys_getdents64(unsigned int fd, struct dirent64 *dirp, unsigned int count)
 	    !(inode = file->f_inode))
 		return -EBADF;
 
-	verify_area(dirp, sizeof (*dirp));
+	if (verify_area(dirp, sizeof (*dirp)))
+		return -EFAULT;
 	return minix_getdents64(inode,file,dirp,count);
 }
 
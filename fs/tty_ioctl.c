@@ -29,7 +29,8 @@ static int get_termios(struct tty_struct * tty, struct termios * termios)
 {
 	int i;
 
-	verify_area(termios, sizeof (*termios));
+	if (verify_area(termios, sizeof (*termios)))
+		return -EFAULT;
 	for (i=0 ; i< (sizeof (*termios)) ; i++)
 		put_fs_byte( ((char *)&tty->termios)[i] , i+(char *)termios );
 	return 0;
@@ -49,7 +50,8 @@ static int get_termio(struct tty_struct * tty, struct termio * termio)
 	int i;
 	struct termio tmp_termio;
 
-	verify_area(termio, sizeof (*termio));
+	if (verify_area(termio, sizeof (*termio)))
+		return -EFAULT;
 	tmp_termio.c_iflag = tty->termios.c_iflag;
 	tmp_termio.c_oflag = tty->termios.c_oflag;
 	tmp_termio.c_cflag = tty->termios.c_cflag;
@@ -132,14 +134,16 @@ int tty_ioctl(int dev, int cmd, int arg)
 		case TIOCSCTTY:
 			return -EINVAL; /* set controlling term NI */
 		case TIOCGPGRP:
-			verify_area((void *) arg,4);
+			if (verify_area((void *) arg,4))
+				return -EFAULT;
 			put_fs_long(tty->pgrp,(unsigned long *) arg);
 			return 0;
 		case TIOCSPGRP:
 			tty->pgrp=get_fs_long((unsigned long *) arg);
 			return 0;
 		case TIOCOUTQ:
-			verify_area((void *) arg,4);
+			if (verify_area((void *) arg,4))
+				return -EFAULT;
 			put_fs_long(CHARS(tty->write_q),(unsigned long *) arg);
 			return 0;
 		case TIOCSTI:
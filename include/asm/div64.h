@@ -0,0 +1,26 @@
+#ifndef _ASM_DIV64_H
+#define _ASM_DIV64_H
+
+/*
+ * do_div(n,base): Divides the unsigned 64-bit lvalue 'n' in place by the
+ * 32-bit 'base' and returns the remainder. gcc would call libgcc for a
+ * 64-bit division, which the kernel doesn't link with; two divl do it.
+ * do_div(n,base): 부호 없는 64비트 lvalue 'n'을 32비트 'base'로 제자리에서
+ * 나누고 나머지를 반환합니다. gcc는 64비트 나눗셈에 커널이 링크하지 않는
+ * libgcc를 호출하므로, 대신 divl 두 번으로 처리합니다.
+ */
+#define do_div(n,base) ({ \
+	unsigned long __upper, __low, __high, __mod, __base = (base); \
+	__asm__("":"=a" (__low), "=d" (__high):"A" (n)); \
+	__upper = __high; \
+	if (__high) { \
+		__upper = __high % __base; \
+		__high = __high / __base; \
+	} \
+	__asm__("divl %2":"=a" (__low), "=d" (__mod) \
+		:"rm" (__base), "0" (__low), "1" (__upper)); \
+	__asm__("":"=A" (n):"a" (__low), "d" (__high)); \
+	__mod; \
+})
+
+#endif
@@ -19,6 +19,11 @@ __asm__ ("movl %%esp,%%eax\n\t" \
 
 #define iret() __asm__ ("iret"::)
 
+#define save_flags(x) \
+__asm__ __volatile__("pushfl ; popl %0":"=r" (x)::"memory")
+#define restore_flags(x) \
+__asm__ __volatile__("pushl %0 ; popfl"::"r" (x):"memory")
+
 #define _set_gate(gate_addr,type,dpl,addr) \
 __asm__ ("movw %%dx,%%ax\n\t" \
 	"movw %0,%%dx\n\t" \
@@ -64,3 +69,38 @@ __asm__ ("movw $104,%1\n\t" \
 
 #define set_tss_desc(n,addr) _set_tssldt_desc(((char *) (n)),addr,"0x89")
 #define set_ldt_desc(n,addr) _set_tssldt_desc(((char *) (n)),addr,"0x82")
+
+/*
+ * have_cpuid: True if the ID flag in eflags can be toggled, i.e. the CPU
+ * has the cpuid instruction. cpuid() keeps %ebx, the PIC register.
+ * have_486: True if the AC flag can be toggled, which a 386 can't.
+ * have_cpuid: eflags의 ID 플래그를 바꿀 수 있으면, 즉 CPU에 cpuid 명령이
+ * 있으면 참입니다. cpuid()는 PIC 레지스터인 %ebx를 보존합니다.
+ * have_486: AC 플래그를 바꿀 수 있으면 참이며, 386은 이를 못 합니다.
+ */
+#define have_cpuid() eflags_toggles(0x200000)
+#define have_486() eflags_toggles(0x40000)
+
+#define eflags_toggles(mask) ({ \
+unsigned long __f1, __f2; \
+__asm__("pushfl\n\t" \
+	"popl %0\n\t" \
+	"movl %0,%1\n\t" \
+	"xorl %2,%0\n\t" \
+	"pushl %0\n\t" \
+	"popfl\n\t" \
+	"pushfl\n\t" \
+	"popl %0\n\t" \
+	"pushl %1\n\t" \
+	"popfl" \
+	:"=&r" (__f1), "=&r" (__f2):"i" (mask)); \
+(__f1 ^ __f2) & (mask);})
+
+#define cpuid(op,eax,edx) \
+__asm__("pushl %%ebx\n\t" \
+	"cpuid\n\t" \
+	"popl %%ebx" \
+	:"=a" (eax), "=d" (edx):"0" (op):"cx")
+
+#define wrmsr(msr,lo,hi) \
+__asm__ __volatile__("wrmsr"::"c" (msr),"a" (lo),"d" (hi))
@@ -0,0 +1,34 @@
+#ifndef _CLOCKSOURCE_H
+#define _CLOCKSOURCE_H
+
+/*
+ * Clocksources. The kernel keeps time in nanoseconds since boot, read
+ * from the best counter found at boot: the TSC, calibrated against the
+ * PIT, or else the PIT counter itself (see kernel/time.c). 'jiffies'
+ * stays the tick count for timeouts and time slices.
+ * 클럭소스. 커널은 부팅 시 찾은 가장 좋은 카운터, 즉 PIT로 보정한 TSC나
+ * 그게 없으면 PIT 카운터 자체에서 읽은 부팅 후 나노초로 시간을 유지합니다
+ * (kernel/time.c 참조). 'jiffies'는 타임아웃과 타임 슬라이스를 위한 틱 수로
+ * 남습니다.
+ */
+
+#define CLOCK_TICK_RATE	1193180		/* PIT input clock, Hz */
+#define LATCH		(CLOCK_TICK_RATE/HZ)	/* PIT count per tick */
+#define NSEC_PER_SEC	1000000000UL
+
+struct clocksource {
+	char * name;
+	unsigned long long (*read)(void);	/* ns since boot */
+	unsigned long res;			/* resolution, ns */
+	void (*tick)(void);			/* called every tick, or NULL */
+};
+
+extern struct clocksource * clocksource;
+
+extern void clocksource_init(void);
+extern unsigned long long pit_clock(void);
+extern unsigned long long get_cycles(void);
+extern void update_time_page(void);
+extern void map_time_page(unsigned long base);
+
+#endif
@@ -18,6 +18,13 @@
 #define BUFFER_END 0xA0000
 #endif
 
+/*
+ * Scheduler for normal (SCHED_OTHER) tasks at bootup: 0 runs them from the
+ * priority arrays with recharged time slices, 1 shares the CPU fairly by
+ * weighted virtual runtime. Real-time tasks are not affected.
+ */
+#define SCHED_FAIR 0
+
 /* Root device at bootup. */
 #define ROOT_DEV 0x301
 
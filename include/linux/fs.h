@@ -38,8 +38,6 @@ void buffer_init(void);
 #define SUPER_MAGIC 0x137F
 
 #define NR_OPEN 20
-#define NR_INODE 32
-#define NR_FILE 64
 #define NR_SUPER 8
 #define NR_HASH 307
 #define NR_BUFFERS nr_buffers
@@ -61,7 +59,7 @@ struct buffer_head {
 	unsigned char b_dirt;		/* 0-clean,1-dirty */
 	unsigned char b_count;		/* users using this block */
 	unsigned char b_lock;		/* 0 - ok, 1 -locked */
-	struct task_struct * b_wait;
+	struct wait_queue * b_wait;
 	struct buffer_head * b_prev;
 	struct buffer_head * b_next;
 	struct buffer_head * b_prev_free;
@@ -87,7 +85,7 @@ struct m_inode {
 	unsigned char i_nlinks;
 	unsigned short i_zone[9];
 /* these are in memory also */
-	struct task_struct * i_wait;
+	struct wait_queue * i_wait;
 	unsigned long i_atime;
 	unsigned long i_ctime;
 	unsigned short i_dev;
@@ -99,6 +97,9 @@ struct m_inode {
 	unsigned char i_mount;
 	unsigned char i_seek;
 	unsigned char i_update;
+	struct m_inode * i_next, * i_prev;		/* all in-core inodes */
+	struct m_inode * i_hash_next, * i_hash_prev;	/* same (dev,num) hash */
+	struct m_inode * i_lru_next, * i_lru_prev;	/* unused, newest first */
 };
 
 #define PIPE_HEAD(inode) (((long *)((inode).i_zone))[0])
@@ -142,8 +143,6 @@ struct dir_entry {
 	char name[NAME_LEN];
 };
 
-extern struct m_inode inode_table[NR_INODE];
-extern struct file file_table[NR_FILE];
 extern struct super_block super_block[NR_SUPER];
 extern struct buffer_head * start_buffer;
 extern int nr_buffers;
@@ -159,6 +158,11 @@ extern int open_namei(const char * pathname, int flag, int mode,
 extern void iput(struct m_inode * inode);
 extern struct m_inode * iget(int dev,int nr);
 extern struct m_inode * get_empty_inode(void);
+extern void insert_inode_hash(struct m_inode * inode);
+extern void inode_init(void);
+extern struct file * get_empty_filp(void);
+extern void put_filp(struct file * f);
+extern void file_table_init(void);
 extern struct m_inode * get_pipe_inode(void);
 extern struct buffer_head * get_hash_table(int dev, int block);
 extern struct buffer_head * getblk(int dev, int block);
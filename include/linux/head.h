@@ -7,6 +7,7 @@ typedef struct desc_struct {
 
 extern unsigned long pg_dir[1024];
 extern desc_table idt,gdt;
+extern int sysenter_enabled;
 
 #define GDT_NUL 0
 #define GDT_CODE 1
@@ -3,8 +3,29 @@
 
 #define PAGE_SIZE 4096
 
+/*
+ * Physical pages come from a buddy allocator (mm/memory.c): blocks of
+ * 2^order contiguous pages, order < MAX_ORDER.
+ * 물리 페이지는 버디 할당기(mm/memory.c)에서 나옵니다: 2^order개의 연속된
+ * 페이지 블록이며, order < MAX_ORDER입니다.
+ */
+#define MAX_ORDER 11
+
+struct free_area {
+	int head;		/* first free block (page number), or -1 */
+	int count;		/* free blocks of this order */
+};
+
+extern struct free_area free_area[MAX_ORDER];
+
+extern void mem_init(void);
+extern unsigned long __get_free_pages(int order);
+extern void free_pages(unsigned long addr, int order);
+extern unsigned long __get_free_page(void);
 extern unsigned long get_free_page(void);
+extern int refill_zero_pool(void);
 extern unsigned long put_page(unsigned long page,unsigned long address);
+extern unsigned long put_kernel_page(unsigned long page,unsigned long address);
 extern void free_page(unsigned long addr);
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+/*
+ * Sampling profiler. While enabled, every timer tick that interrupts the
+ * profiled code adds one to the histogram bucket of the interrupted EIP.
+ * PROF_KERNEL samples the kernel text (0 to 'etext', resolve the buckets
+ * against System.map), PROF_USER a range of the calling process. Bucket
+ * i covers the addresses low + (i << shift) up to the next bucket.
+ * 샘플링 프로파일러. 활성화되어 있는 동안, 프로파일 대상 코드를 인터럽트한
+ * 모든 타이머 틱은 인터럽트된 EIP의 히스토그램 버킷에 1을 더합니다.
+ * PROF_KERNEL은 커널 텍스트(0부터 'etext'까지, 버킷은 System.map으로
+ * 해석)를, PROF_USER는 호출한 프로세스의 범위를 샘플링합니다. 버킷 i는
+ * low + (i << shift)부터 다음 버킷 직전까지의 주소를 담당합니다.
+ */
+
+/* prof() commands / prof() 명령 */
+#define PROF_OFF	0	/* stop sampling */
+#define PROF_KERNEL	1	/* clear and sample the kernel text */
+#define PROF_USER	2	/* clear and sample the prof_range at buf */
+#define PROF_READ	3	/* copy up to arg buckets into buf */
+#define PROF_INFO	4	/* copy a struct prof_info into buf */
+
+#define PROF_BUCKETS	4096
+
+struct prof_range {
+	unsigned long low, high;	/* [low, high) */
+};
+
+struct prof_info {
+	long mode;			/* PROF_OFF/KERNEL/USER */
+	long pid;			/* profiled process, PROF_USER */
+	unsigned long low, high;
+	long shift;			/* log2 of the bucket size */
+	long buckets;			/* buckets in use */
+	unsigned long samples;		/* ticks inside the range */
+	unsigned long missed;		/* ticks outside it */
+};
+
+extern int prof_mode;
+
+extern void __profile_tick(long cpl, unsigned long eip);
+
+#define profile_tick(cpl,eip) \
+	do { if (prof_mode) __profile_tick(cpl,eip); } while (0)
+
+#endif
@@ -4,12 +4,30 @@
 #define NR_TASKS 64
 #define HZ 100
 
+/*
+ * Run queue levels: level 0 is served first. Real-time tasks take the
+ * first MAX_RT_PRIO levels by rt_priority, normal tasks the NICE_LEVELS
+ * after them by static priority, see prio_level() in kernel/sched.c.
+ * 실행 큐 레벨: 레벨 0이 가장 먼저 실행됩니다. 실시간 태스크는
+ * rt_priority에 따라 처음 MAX_RT_PRIO개 레벨을, 일반 태스크는 정적
+ * 우선순위에 따라 그 뒤의 NICE_LEVELS개 레벨을 차지하며, kernel/sched.c의
+ * prio_level()을 참조하세요.
+ */
+#define MAX_RT_PRIO 100
+#define NICE_LEVELS 40
+#define MAX_PRIO (MAX_RT_PRIO+NICE_LEVELS)
+#define PRIO_WORDS ((MAX_PRIO+31)>>5)
+
 #define FIRST_TASK task[0]
 #define LAST_TASK task[NR_TASKS-1]
 
 #include <linux/head.h>
 #include <linux/fs.h>
 #include <linux/mm.h>
+#include <linux/timer.h>
+#include <linux/wait.h>
+#include <linux/trace.h>
+#include <sched.h>
 
 #if (NR_OPEN > 32)
 #error "Currently the close-on-exec-flags are in one word, max 32 files/proc"
@@ -26,7 +44,7 @@
 #endif
 
 extern int copy_page_tables(unsigned long from, unsigned long to, long size);
-extern int free_page_tables(unsigned long from, long size);
+extern int free_page_tables(unsigned long from, unsigned long size);
 
 extern void sched_init(void);
 extern void schedule(void);
@@ -36,6 +54,24 @@ extern int tty_write(unsigned minor,char * buf,int count);
 
 typedef int (*fn_ptr)();
 
+struct prio_array;
+
+/*
+ * A file-backed range of the executable: 'size' bytes at task address
+ * 'addr' come from file offset 'offset'. exec() only records these and
+ * do_no_page() reads a page in on the first touch; the rest of the image
+ * (bss, heap) is demand-zero.
+ * 실행 파일의 파일 기반 범위: 태스크 주소 'addr'의 'size' 바이트는 파일
+ * 오프셋 'offset'에서 옵니다. exec()는 이를 기록만 하고 do_no_page()가 처음
+ * 접근할 때 페이지를 읽어 들입니다. 이미지의 나머지(bss, 힙)는 0으로 채운
+ * 페이지가 요청 시 할당됩니다.
+ */
+#define NR_EXEC_REGIONS 8
+
+struct exec_region {
+	unsigned long addr, size, offset;
+};
+
 struct i387_struct {
 	long	cwd;
 	long	swd;
@@ -88,7 +124,6 @@ struct task_struct {
 	long pid,father,pgrp,session,leader;
 	unsigned short uid,euid,suid;
 	unsigned short gid,egid,sgid;
-	long alarm;
 	long utime,stime,cutime,cstime,start_time;
 	unsigned short used_math;
 /* file system info */
@@ -102,6 +137,27 @@ struct task_struct {
 	struct desc_struct ldt[3];
 /* tss for this task */
 	struct tss_struct tss;
+/* run queue links, array is NULL while not queued */
+	struct task_struct * run_next, * run_prev;
+	struct prio_array * array;
+/* SIGALRM timer for alarm() */
+	struct timer_list alarm_timer;
+/* scheduler tracing: last wakeup (us), wakeup latency histogram */
+	unsigned long long wakeup_time;
+	unsigned long lat_hist[LAT_BUCKETS];
+/* scheduling class: SCHED_OTHER/FIFO/RR, and priority 1..99 if real-time */
+	long policy, rt_priority;
+/* CPU time (ns) and when it was last charged, see update_curr() */
+	unsigned long long sum_exec_runtime, exec_start;
+/* fair scheduler: weighted run time (ns), heap slot */
+	unsigned long long vruntime;
+	int heap_index;
+/* system call statistics: when the current call started, see sysstat.c */
+	unsigned long long syscall_start;
+/* demand-paged executable image, see do_no_page() */
+	struct m_inode * executable;
+	int nr_regions;
+	struct exec_region regions[NR_EXEC_REGIONS];
 };
 
 /*
@@ -114,7 +170,7 @@ struct task_struct {
 /* ec,brk... */	0,0,0,0,0, \
 /* pid etc.. */	0,-1,0,0,0, \
 /* uid etc */	0,0,0,0,0,0, \
-/* alarm */	0,0,0,0,0,0, \
+/* times */	0,0,0,0,0, \
 /* math */	0, \
 /* fs info */	-1,0133,NULL,NULL,0, \
 /* filp */	{NULL,}, \
@@ -139,13 +195,21 @@ extern long startup_time;
 
 #define CURRENT_TIME (startup_time+jiffies/HZ)
 
-extern void sleep_on(struct task_struct ** p);
-extern void interruptible_sleep_on(struct task_struct ** p);
-extern void wake_up(struct task_struct ** p);
+extern void wake_up_process(struct task_struct * p);
+extern void del_from_runqueue(struct task_struct * p);
+extern unsigned long long sched_clock(void);
+extern int need_resched;
+
+#define rt_task(p) ((p)->policy != SCHED_OTHER)
 
 /*
  * Entry into gdt where to find first TSS. 0-nul, 1-cs, 2-ds, 3-syscall
  * 4-TSS0, 5-LDT0, 6-TSS1 etc ...
+ *
+ * Only TSS0 is used now: it is the single 'cpu_tss' shared by all tasks,
+ * whose esp0 is updated on every switch. The per-task LDT slots stay.
+ * 이제 TSS0만 사용됩니다: 모든 태스크가 공유하는 단일 'cpu_tss'이며, 전환마다
+ * esp0가 갱신됩니다. 태스크별 LDT 슬롯은 그대로 유지됩니다.
  */
 #define FIRST_TSS_ENTRY 4
 #define FIRST_LDT_ENTRY (FIRST_TSS_ENTRY+1)
@@ -159,26 +223,48 @@ __asm__("str %%ax\n\t" \
 	"shrl $4,%%eax" \
 	:"=a" (n) \
 	:"a" (0),"i" (FIRST_TSS_ENTRY<<3))
+extern struct tss_struct cpu_tss;
+
+extern void __attribute__((regparm(2)))
+	__switch_to(struct task_struct * prev, struct task_struct * next);
+
 /*
- *	switch_to(n) should switch tasks to task nr n, first
- * checking that n isn't the current task, in which case it does nothing.
- * This also clears the TS-flag if the task we switched to has used
+ *	switch_to(prev,next) switches from task 'prev' (current) to 'next'
+ * in software: the callee-saved registers and eflags go on prev's kernel
+ * stack, its esp and resume address into prev->tss, and next's are
+ * loaded back. __switch_to() does the rest (esp0, LDT, fs/gs, current)
+ * and also sets the TS-flag unless the task we switched to has used
  * tha math co-processor latest.
+ *	switch_to(prev,next)는 소프트웨어로 태스크 'prev'(current)에서 'next'로
+ * 전환합니다: 호출 보존 레지스터와 eflags는 prev의 커널 스택에, esp와 재개
+ * 주소는 prev->tss에 저장하고 next의 것을 다시 적재합니다. 나머지(esp0, LDT,
+ * fs/gs, current)는 __switch_to()가 처리하며, 전환 대상 태스크가 수학
+ * 보조 프로세서를 마지막으로 사용하지 않았다면 TS 플래그도 설정합니다.
  */
-#define switch_to(n) {\
-struct {long a,b;} __tmp; \
-__asm__ __volatile__("cmpl %%ecx,current\n\t" \
-	"je 1f\n\t" \
-	"xchgl %%ecx,current\n\t" \
-	"movw %%dx,%1\n\t" \
-	"ljmp *%0\n\t" \
-	"cmpl %%ecx,%2\n\t" \
-	"jne 1f\n\t" \
-	"clts\n" \
-	"1:\n\t" \
-	::"m" (*&__tmp.a),"m" (*&__tmp.b), \
-	"m" (last_task_used_math),"d" _TSS(n),"c" ((long) task[n])); \
-}
+#define switch_to(prev,next) do { \
+unsigned long __d0, __d1, __d2; \
+__asm__ __volatile__("pushfl\n\t" \
+	"pushl %%ebx\n\t" \
+	"pushl %%esi\n\t" \
+	"pushl %%edi\n\t" \
+	"pushl %%ebp\n\t" \
+	"movl %%esp,%0\n\t" \
+	"movl %5,%%esp\n\t" \
+	"movl $1f,%1\n\t" \
+	"pushl %6\n\t" \
+	"jmp __switch_to\n" \
+	"1:\t" \
+	"popl %%ebp\n\t" \
+	"popl %%edi\n\t" \
+	"popl %%esi\n\t" \
+	"popl %%ebx\n\t" \
+	"popfl" \
+	:"=m" ((prev)->tss.esp),"=m" ((prev)->tss.eip), \
+	 "=a" (__d0),"=d" (__d1),"=c" (__d2) \
+	:"m" ((next)->tss.esp),"m" ((next)->tss.eip), \
+	 "2" (prev),"3" (next) \
+	:"memory"); \
+} while (0)
 
 #define PAGE_ALIGN(n) (((n)+0xfff)&0xfffff000)
 
@@ -0,0 +1,48 @@
+#ifndef _SLAB_H
+#define _SLAB_H
+
+/*
+ * The slab allocator (mm/slab.c). A cache hands out objects of one size,
+ * carved from whole pages ('slabs'). The constructor runs once, when a
+ * slab is created; objects must be given back to kmem_cache_free() in
+ * their constructed state, so the next allocation can skip it. kmalloc()
+ * serves sizes up to KMALLOC_MAX from a set of power-of-two caches.
+ * A cache that keeps unused objects around (the inode cache) sets
+ * 'shrink', so kmem_cache_reap() can take them back when the page
+ * allocator runs out.
+ * 슬랩 할당기 (mm/slab.c). 캐시는 한 크기의 객체를 나눠 주며, 객체는 통째의
+ * 페이지('슬랩')에서 잘라냅니다. 생성자는 슬랩이 만들어질 때 한 번 실행되며,
+ * 객체는 생성된 상태로 kmem_cache_free()에 돌려줘야 다음 할당이 이를 건너뛸
+ * 수 있습니다. kmalloc()은 2의 거듭제곱 크기 캐시들로 KMALLOC_MAX까지의
+ * 크기를 제공합니다. 사용하지 않는 객체를 남겨 두는 캐시(아이노드 캐시)는
+ * 'shrink'를 설정하여, 페이지 할당기가 바닥났을 때 kmem_cache_reap()이 이를
+ * 회수할 수 있게 합니다.
+ */
+
+#define KMALLOC_MAX	2048
+
+struct slab;
+
+struct kmem_cache {
+	char * name;
+	int size;			/* object size, rounded up */
+	int num;			/* objects per slab */
+	int offset;			/* of the first object in the slab */
+	void (*ctor)(void *);
+	struct slab * partial, * full, * empty;
+	int nr_empty;
+	unsigned long nr_objs, nr_active;
+	struct kmem_cache * next;
+	int (*shrink)(int nr);		/* frees up to nr unused objects, or NULL */
+};
+
+extern struct kmem_cache * kmem_cache_create(char * name, int size,
+	void (*ctor)(void *));
+extern void * kmem_cache_alloc(struct kmem_cache * cache);
+extern void kmem_cache_free(struct kmem_cache * cache, void * obj);
+extern int kmem_cache_reap(void);
+
+extern void * kmalloc(unsigned int size);
+extern void kfree(void * obj);
+
+#endif
@@ -75,6 +75,18 @@ extern int sys_lstat64();
 extern int sys_fstat64();
 extern int sys_getdents64();
 extern int sys_fcntl64();
+extern int sys_splice();
+extern int sys_tee();
+extern int sys_sched_setparam();
+extern int sys_sched_getparam();
+extern int sys_sched_setscheduler();
+extern int sys_sched_getscheduler();
+extern int sys_sched_yield();
+extern int sys_sched_trace();
+extern int sys_syscall_stat();
+extern int sys_gettimeofday();
+extern int sys_clock_gettime();
+extern int sys_clock_getres();
 extern int sys_null();	/* not implemented sys_call */
 
 fn_ptr sys_call_table[] = { sys_setup, sys_exit, sys_fork, sys_read,
@@ -91,7 +103,7 @@ sys_oldolduname, sys_umask, sys_chroot, sys_ustat, sys_dup2, sys_getppid,
 sys_getpgrp,sys_setsid, sys_null /*67*/,sys_null,sys_null,
 
 /* 70 */sys_null,sys_null,sys_null,sys_null,sys_null,
-sys_null,sys_null,sys_null,sys_null,sys_null,
+sys_null,sys_null,sys_null,sys_gettimeofday,sys_null,
 /* 80 */sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 90 */sys_null,sys_null,sys_null,sys_null,sys_null,
@@ -106,8 +118,9 @@ sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 140 */sys_null,sys_getdents,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
-/* 150 */sys_null,sys_null,sys_null,sys_null,sys_null,
-sys_null,sys_null,sys_null,sys_null,sys_null,
+/* 150 */sys_null,sys_null,sys_null,sys_null,sys_sched_setparam,
+sys_sched_getparam,sys_sched_setscheduler,sys_sched_getscheduler,
+sys_sched_yield,sys_null,
 /* 160 */sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 170 */sys_null,sys_null,sys_null,sys_null,sys_null,
@@ -129,7 +142,7 @@ sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 250 */sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 260 */sys_null,sys_null,sys_null,sys_null,sys_null,
-sys_null,sys_null,sys_null,sys_null,sys_null,
+sys_clock_gettime,sys_clock_getres,sys_null,sys_null,sys_null,
 /* 270 */sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 280 */sys_null,sys_null,sys_null,sys_null,sys_null,
@@ -138,7 +151,8 @@ sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
 /* 300 */sys_null,sys_null,sys_null,sys_null,sys_null,
 sys_null,sys_null,sys_null,sys_null,sys_null,
-/* 310 */sys_null,sys_null,sys_null,sys_null,sys_null,
-sys_null,sys_null,sys_null,sys_null,sys_null
+/* 310 */sys_null,sys_null,sys_null,sys_splice,sys_null,
+sys_tee,sys_null,sys_null,sys_null,sys_null,
+/* 320 */sys_sched_trace,sys_syscall_stat
 };
 
@@ -0,0 +1,41 @@
+#ifndef _SYSSTAT_H
+#define _SYSSTAT_H
+
+/*
+ * System call statistics. While enabled with syscall_stat(SYSSTAT_ON, 0),
+ * system_call counts every call per number, with its errors and a
+ * histogram of how long it took, in TSC cycles (nanoseconds on CPUs
+ * without a TSC). Blocking calls include the time spent asleep.
+ * 시스템 호출 통계. syscall_stat(SYSSTAT_ON, 0)으로 활성화되어 있는 동안
+ * system_call은 모든 호출을 번호별로 세고, 그 오류와 걸린 시간의
+ * 히스토그램을 TSC 사이클(TSC가 없는 CPU에서는 나노초)로 기록합니다. 블록되는
+ * 호출은 잠들어 있던 시간을 포함합니다.
+ */
+
+#define NR_SYSCALLS	322	/* nr_system_calls in kernel/system_call.s */
+
+/* syscall_stat() commands / syscall_stat() 명령 */
+#define SYSSTAT_OFF	0	/* stop counting */
+#define SYSSTAT_ON	1	/* clear the counters and start counting */
+#define SYSSTAT_READ	2	/* copy the counters of call number arg into buf */
+
+/*
+ * Latency histogram: bucket 0 counts calls below 2 cycles, bucket i calls
+ * taking [2^i, 2^(i+1)) cycles, and the last bucket everything longer.
+ * 지연 히스토그램: 버킷 0은 2 사이클 미만의 호출을, 버킷 i는
+ * [2^i, 2^(i+1)) 사이클이 걸린 호출을, 마지막 버킷은 그보다 긴 모든 호출을
+ * 셉니다.
+ */
+#define SYSSTAT_BUCKETS	32
+
+struct syscall_stat {
+	unsigned long calls;
+	unsigned long errors;		/* returned -1..-4095 */
+	unsigned long enosys;		/* of which -ENOSYS */
+	unsigned long long cycles;	/* total */
+	unsigned long hist[SYSSTAT_BUCKETS];
+};
+
+extern int sysstat_on;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _TIMER_H
+#define _TIMER_H
+
+/*
+ * Kernel timers. A timer calls 'function(data)' from the timer interrupt
+ * once 'jiffies' has reached 'expires'. Timers live in a hierarchical
+ * wheel (see kernel/timer.c), so adding, removing and expiring one is
+ * O(1) no matter how many are pending.
+ * 커널 타이머. 'jiffies'가 'expires'에 도달하면 타이머 인터럽트에서
+ * 'function(data)'를 호출합니다. 타이머는 계층적 휠(kernel/timer.c 참조)에
+ * 있으므로 대기 중인 타이머 수와 무관하게 추가, 제거, 만료가 O(1)입니다.
+ *
+ * Timer functions run with interrupts off and must not sleep.
+ * 타이머 함수는 인터럽트가 꺼진 상태에서 실행되며 대기해서는 안 됩니다.
+ */
+struct timer_list {
+	struct timer_list * next;
+	struct timer_list ** pprev;	/* NULL if not pending */
+	unsigned long expires;
+	unsigned long data;
+	void (*function)(unsigned long);
+};
+
+extern void init_timer(struct timer_list * timer);
+extern void add_timer(struct timer_list * timer);
+extern int del_timer(struct timer_list * timer);
+extern int mod_timer(struct timer_list * timer, unsigned long expires);
+extern void run_timers(void);
+extern unsigned long timer_idle_ticks(unsigned long max);
+
+#define timer_pending(timer) ((timer)->pprev != NULL)
+
+#endif
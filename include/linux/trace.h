@@ -0,0 +1,62 @@
+#ifndef _TRACE_H
+#define _TRACE_H
+
+/*
+ * Scheduler tracing. While enabled with sched_trace(TRACE_ON, mask), the
+ * kernel records timestamped scheduler events into a ring buffer
+ * (TRACE_EVENTS) and/or keeps a per-task histogram of how long a task
+ * waited between being woken and getting the CPU (TRACE_LATENCY_HIST).
+ * 스케줄러 추적. sched_trace(TRACE_ON, mask)로 활성화되어 있는 동안, 커널은
+ * 타임스탬프가 찍힌 스케줄러 이벤트를 링 버퍼에 기록하거나(TRACE_EVENTS),
+ * 태스크가 깨어난 뒤 CPU를 얻기까지 기다린 시간의 태스크별 히스토그램을
+ * 유지합니다(TRACE_LATENCY_HIST).
+ */
+
+/* sched_trace() commands / sched_trace() 명령 */
+#define TRACE_OFF	0	/* stop tracing */
+#define TRACE_ON	1	/* arg = mask below; clears the ring buffer */
+#define TRACE_READ	2	/* copy and consume up to arg events into buf */
+#define TRACE_LATENCY	3	/* copy pid arg's histogram into buf */
+#define TRACE_RESET	4	/* clear pid arg's histogram (0 = all) */
+
+#define TRACE_EVENTS	0x01
+#define TRACE_LATENCY_HIST 0x02
+
+/* event types / 이벤트 종류 */
+#define TRACE_SWITCH	1	/* pid = prev, arg = next pid, state = prev state */
+#define TRACE_WAKEUP	2	/* pid = woken, arg = waker pid */
+#define TRACE_SLEEP	3	/* pid = sleeper, arg = wait channel */
+
+struct trace_event {
+	unsigned long long time;	/* nanoseconds since boot */
+	long type;
+	long pid;
+	long arg;
+	long state;
+};
+
+/*
+ * Latency histogram: bucket 0 counts waits below 2us, bucket i waits in
+ * [2^i, 2^(i+1)) us, and the last bucket everything longer.
+ * 지연 히스토그램: 버킷 0은 2us 미만의 대기를, 버킷 i는 [2^i, 2^(i+1)) us의
+ * 대기를, 마지막 버킷은 그보다 긴 모든 대기를 셉니다.
+ */
+#define LAT_BUCKETS	20
+
+struct task_struct;
+struct wait_queue;
+
+extern int sched_trace_flags;
+
+extern void __trace_switch(struct task_struct * prev, struct task_struct * next);
+extern void __trace_wakeup(struct task_struct * p);
+extern void __trace_sleep(struct wait_queue ** q);
+
+#define trace_switch(prev,next) \
+	do { if (sched_trace_flags) __trace_switch(prev,next); } while (0)
+#define trace_wakeup(p) \
+	do { if (sched_trace_flags) __trace_wakeup(p); } while (0)
+#define trace_sleep(q) \
+	do { if (sched_trace_flags & TRACE_EVENTS) __trace_sleep(q); } while (0)
+
+#endif
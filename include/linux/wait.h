@@ -0,0 +1,42 @@
+#ifndef _WAIT_H
+#define _WAIT_H
+
+/*
+ * Wait queues. A wait queue is a pointer to a list of wait_queue entries,
+ * one per sleeping task, each living on that task's kernel stack while it
+ * sleeps. wake_up() wakes every normal waiter but only the first sleeping
+ * exclusive one, so resources that can satisfy a single waiter at a time
+ * (a free request slot, an inode lock) don't wake the whole herd.
+ * 대기 큐. 대기 큐는 wait_queue 엔트리 리스트에 대한 포인터이며, 엔트리는
+ * 대기 중인 태스크마다 하나씩 해당 태스크의 커널 스택에 놓입니다. wake_up()은
+ * 모든 일반 대기자를 깨우지만 배타적 대기자는 대기 중인 첫 번째 하나만 깨우므로,
+ * 한 번에 한 대기자만 만족시킬 수 있는 자원(빈 요청 슬롯, 아이노드 잠금)이
+ * 대기자 전체를 깨우지 않습니다.
+ *
+ * The queue head is a single pointer, so it can stand in for the old
+ * 'struct task_struct *' fields without changing structure layouts.
+ * 큐 헤드는 포인터 하나이므로, 구조체 레이아웃을 바꾸지 않고 기존
+ * 'struct task_struct *' 필드를 대신할 수 있습니다.
+ */
+struct task_struct;
+
+#define WQ_FLAG_EXCLUSIVE	0x01
+
+struct wait_queue {
+	struct task_struct * task;
+	struct wait_queue * next;
+	int flags;
+};
+
+extern void add_wait_queue(struct wait_queue ** q, struct wait_queue * wait);
+extern void add_wait_queue_exclusive(struct wait_queue ** q,
+	struct wait_queue * wait);
+extern void remove_wait_queue(struct wait_queue ** q, struct wait_queue * wait);
+
+extern void sleep_on(struct wait_queue ** q);
+extern void sleep_on_exclusive(struct wait_queue ** q);
+extern void interruptible_sleep_on(struct wait_queue ** q);
+extern void wake_up(struct wait_queue ** q);
+extern void wake_up_all(struct wait_queue ** q);
+
+#endif
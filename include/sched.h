@@ -0,0 +1,34 @@
+#ifndef _POSIX_SCHED_H
+#define _POSIX_SCHED_H
+
+#include <sys/types.h>
+
+/*
+ * Scheduling policies. SCHED_FIFO and SCHED_RR tasks have a static
+ * priority 1..99 and always run before SCHED_OTHER tasks. A SCHED_FIFO
+ * task runs until it blocks or yields; SCHED_RR tasks of equal priority
+ * take turns by time slice.
+ * 스케줄링 정책. SCHED_FIFO와 SCHED_RR 태스크는 1..99의 정적 우선순위를
+ * 가지며 항상 SCHED_OTHER 태스크보다 먼저 실행됩니다. SCHED_FIFO 태스크는
+ * 대기하거나 양보할 때까지 실행되고, 같은 우선순위의 SCHED_RR 태스크는
+ * 타임 슬라이스마다 번갈아 실행됩니다.
+ */
+#define SCHED_OTHER	0
+#define SCHED_FIFO	1
+#define SCHED_RR	2
+
+#define SCHED_RT_PRIO_MIN	1
+#define SCHED_RT_PRIO_MAX	99
+
+struct sched_param {
+	int sched_priority;
+};
+
+extern int sched_setparam(pid_t pid, const struct sched_param * param);
+extern int sched_getparam(pid_t pid, struct sched_param * param);
+extern int sched_setscheduler(pid_t pid, int policy,
+	const struct sched_param * param);
+extern int sched_getscheduler(pid_t pid);
+extern int sched_yield(void);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef _SYS_TIMEPAGE_H
+#define _SYS_TIMEPAGE_H
+
+#include <sys/types.h>
+
+/*
+ * The time page. exec() maps this page read-only at TIME_PAGE_ADDR in
+ * every process, and the kernel updates it on every tick, so time can be
+ * read without a system call. 'seq' is odd while an update is in
+ * progress: read it, read the fields, and retry if 'seq' was odd or has
+ * changed meanwhile (time_page_ns() below does this).
+ * 시간 페이지. exec()는 이 페이지를 모든 프로세스의 TIME_PAGE_ADDR에 읽기
+ * 전용으로 매핑하고, 커널은 매 틱마다 갱신하므로 시스템 호출 없이 시간을 읽을
+ * 수 있습니다. 'seq'는 갱신 중에 홀수입니다: 이를 읽고, 필드를 읽은 뒤,
+ * 'seq'가 홀수였거나 그 사이에 바뀌었으면 다시 시도합니다(아래의
+ * time_page_ns()가 이렇게 합니다).
+ */
+#define TIME_PAGE_ADDR	0x3fff000	/* last page of the 64MB task space */
+
+#define TP_CLOCK_JIFFIES 0	/* only jiffies: tick resolution */
+#define TP_CLOCK_TSC	1	/* ns = tsc_last_ns + (tsc-tsc_last)*tsc_mult >> TP_TSC_SHIFT */
+
+#define TP_TSC_SHIFT	22
+
+struct time_page {
+	unsigned long seq;
+	long jiffies;
+	time_t startup_time;		/* wall clock seconds at jiffies 0 */
+	long hz;
+	unsigned long tick_ns;
+	long clock_mode;
+	unsigned long tsc_mult;
+	unsigned long long tsc_last;
+	unsigned long long tsc_last_ns;
+	long sysenter;			/* 1: enter the kernel with sysenter */
+};
+
+#define TIME_PAGE ((volatile struct time_page *) TIME_PAGE_ADDR)
+
+/*
+ * time_page_ns: Nanoseconds since boot, like clock_gettime(CLOCK_MONOTONIC).
+ * time_page_ns: 부팅 후 나노초로, clock_gettime(CLOCK_MONOTONIC)과 같습니다.
+ */
+static inline unsigned long long time_page_ns(void)
+{
+	volatile struct time_page * tp = TIME_PAGE;
+	unsigned long long ns, tsc;
+	unsigned long seq;
+
+	do {
+		while ((seq = tp->seq) & 1)
+			;
+		if (tp->clock_mode == TP_CLOCK_TSC) {
+			__asm__ __volatile__("rdtsc":"=A" (tsc));
+			ns = tp->tsc_last_ns +
+				(((tsc - tp->tsc_last) * tp->tsc_mult) >> TP_TSC_SHIFT);
+		} else
+			ns = (unsigned long long) tp->jiffies * tp->tick_ns;
+	} while (seq != tp->seq);
+	return ns;
+}
+
+/*
+ * time_page_time: Seconds since the epoch, like time().
+ * time_page_time: 에포크 이후 초로, time()과 같습니다.
+ */
+static inline time_t time_page_time(void)
+{
+	volatile struct time_page * tp = TIME_PAGE;
+	unsigned long seq;
+	time_t t;
+
+	do {
+		while ((seq = tp->seq) & 1)
+			;
+		t = tp->startup_time + tp->jiffies / tp->hz;
+	} while (seq != tp->seq);
+	return t;
+}
+
+#endif
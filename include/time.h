@@ -15,6 +15,18 @@ typedef unsigned int size_t;
 
 typedef long clock_t;
 
+struct timespec {
+	time_t tv_sec;		/* seconds */
+	long tv_nsec;		/* nanoseconds */
+};
+
+typedef int clockid_t;
+
+#define CLOCK_REALTIME			0
+#define CLOCK_MONOTONIC			1
+#define CLOCK_PROCESS_CPUTIME_ID	2
+#define CLOCK_THREAD_CPUTIME_ID		3
+
 struct tm {
 	int tm_sec;
 	int tm_min;
@@ -38,5 +50,7 @@ struct tm * gmtime(const time_t *tp);
 struct tm *localtime(const time_t * tp);
 size_t strftime(char * s, size_t smax, const char * fmt, const struct tm * tp);
 void tzset(void);
+int clock_gettime(clockid_t clock_id, struct timespec * tp);
+int clock_getres(clockid_t clock_id, struct timespec * res);
 
 #endif
@@ -125,24 +125,74 @@
 #define __NR_getppid	64
 #define __NR_getpgrp	65
 #define __NR_setsid		66
+#define __NR_gettimeofday	78
 #define __NR_stat		106
 #define __NR_lstat		107
 #define __NR_fstat		108
 #define __NR_uname		122
 #define __NR_getdents	141
+#define __NR_sched_setparam	154
+#define __NR_sched_getparam	155
+#define __NR_sched_setscheduler	156
+#define __NR_sched_getscheduler	157
+#define __NR_sched_yield	158
 #define __NR_stat64		195
 #define __NR_ltat64		196
 #define __NR_fstat64	197
 #define __NR_getdents64	220
 #define __NR_fcntl64	221
+#define __NR_clock_gettime	265
+#define __NR_clock_getres	266
+#define __NR_splice	313
+#define __NR_tee		315
+#define __NR_sched_trace	320
+#define __NR_syscall_stat	321
+
+/*
+ * __syscall: The system call stub. Programs enter with sysenter when the
+ * kernel says so in the time page, passing the return address in %esi and
+ * the stack pointer in %ebp, and fall back to int 0x80 otherwise. The
+ * kernel's own library (built with __KERNEL__) runs in tasks 0 and 1
+ * before they exec anything, where no time page is mapped: it always
+ * uses int 0x80.
+ * __syscall: 시스템 호출 스텁. 프로그램은 커널이 시간 페이지에서 허용하면
+ * 복귀 주소를 %esi에, 스택 포인터를 %ebp에 넘기고 sysenter로 진입하며,
+ * 그렇지 않으면 int 0x80으로 대체합니다. (__KERNEL__로 빌드되는) 커널 자체의
+ * 라이브러리는 태스크 0과 1이 아무것도 exec하기 전, 즉 시간 페이지가 매핑되지
+ * 않은 상태에서 실행되므로 항상 int 0x80을 사용합니다.
+ */
+#ifndef __KERNEL__
+#include <sys/timepage.h>
+#endif
+
+static inline long __syscall(long nr, long a, long b, long c)
+{
+	long res;
+
+#ifndef __KERNEL__
+	if (TIME_PAGE->sysenter) {
+		__asm__ volatile ("pushl %%ebp\n\t"
+			"movl %%esp,%%ebp\n\t"
+			"movl $1f,%%esi\n\t"
+			"sysenter\n"
+			"1:\tpopl %%ebp"
+			: "=a" (res)
+			: "0" (nr),"b" (a),"c" (b),"d" (c)
+			: "si");
+		return res;
+	}
+#endif
+	__asm__ volatile ("int $0x80"
+		: "=a" (res)
+		: "0" (nr),"b" (a),"c" (b),"d" (c));
+	return res;
+}
 
 #define _syscall0(type,name) \
 type name(void) \
 { \
 type __res; \
-__asm__ volatile ("int $0x80" \
-	: "=a" (__res) \
-	: "0" (__NR_##name)); \
+__res = (type) __syscall(__NR_##name,0,0,0); \
 if (__res >= 0) \
 	return __res; \
 errno = -__res; \
@@ -153,9 +203,7 @@ return -1; \
 type name(atype a) \
 { \
 type __res; \
-__asm__ volatile ("int $0x80" \
-	: "=a" (__res) \
-	: "0" (__NR_##name),"b" (a)); \
+__res = (type) __syscall(__NR_##name,(long) (a),0,0); \
 if (__res >= 0) \
 	return __res; \
 errno = -__res; \
@@ -166,9 +214,7 @@ return -1; \
 type name(atype a,btype b) \
 { \
 type __res; \
-__asm__ volatile ("int $0x80" \
-	: "=a" (__res) \
-	: "0" (__NR_##name),"b" (a),"c" (b)); \
+__res = (type) __syscall(__NR_##name,(long) (a),(long) (b),0); \
 if (__res >= 0) \
 	return __res; \
 errno = -__res; \
@@ -179,9 +225,7 @@ return -1; \
 type name(atype a,btype b,ctype c) \
 { \
 type __res; \
-__asm__ volatile ("int $0x80" \
-	: "=a" (__res) \
-	: "0" (__NR_##name),"b" (a),"c" (b),"d" (c)); \
+__res = (type) __syscall(__NR_##name,(long) (a),(long) (b),(long) (c)); \
 if (__res<0) \
 	errno=-__res , __res = -1; \
 return __res;\
@@ -256,5 +300,10 @@ pid_t getpgrp(void);
 pid_t setsid(void);
 int getdents(unsigned int fd, struct dirent *dirp, unsigned int count);
 int getdents64(unsigned int fd, struct dirent64 *dirp, unsigned int count);
+int splice(int fd_in, int fd_out, int len);
+int tee(int fd_in, int fd_out, int len);
+int sched_trace(int cmd, long arg, void * buf);
+int syscall_stat(int cmd, long arg, void * buf);
+int prof(int cmd, long arg, void * buf);
 
 #endif
@@ -90,11 +90,14 @@ int main(void)		/* This really IS void, no error here. */
  * Interrupts are still disabled. Do necessary setups, then
  * enable them
  */
+	mem_init();
 	time_init();
 	tty_init();
 	trap_init();
 	sched_init();
 	buffer_init();
+	inode_init();
+	file_table_init();
 	hd_init();
 	sti();
 	move_to_user_mode();
@@ -105,8 +108,8 @@ int main(void)		/* This really IS void, no error here. */
  *   NOTE!!   For any other task 'pause()' would mean we have to get a
  * signal to awaken, but task0 is the sole exception (see 'schedule()')
  * as task 0 gets activated at every idle moment (when no other tasks
- * can run). For task0 'pause()' just means we go check if some other
- * task can run, and if not we return here.
+ * can run). For task0 'pause()' halts the CPU until some other task
+ * can run (see 'cpu_idle()'), and then we return here.
  */
 	for(;;) pause();
 
@@ -31,6 +31,7 @@ void release(struct task_struct * p)
 		return;
 	for (i=1 ; i<NR_TASKS ; i++)
 		if (task[i]==p) {
+			del_from_runqueue(p);
 			task[i]=NULL;
 			free_page((long)p);
 			schedule();
@@ -51,8 +52,11 @@ static inline void send_sig(long sig,struct task_struct * p,int priv)
 		current->uid==p->uid ||
 		current->euid==p->uid ||
 		current->uid==p->euid ||
-		current->euid==p->euid)
+		current->euid==p->euid) {
 		p->signal |= (1<<(sig-1));
+		if (p->state == TASK_INTERRUPTIBLE)
+			wake_up_process(p);
+	}
 }
 
 /*
@@ -86,6 +90,7 @@ int do_exit(long code)
 {
 	int i;
 
+	del_timer(&current->alarm_timer);
 	free_page_tables(get_base(current->ldt[1]),get_limit(0x0f));
 	free_page_tables(get_base(current->ldt[2]),get_limit(0x17));
 	for (i=0 ; i<NR_TASKS ; i++)
@@ -98,6 +103,8 @@ int do_exit(long code)
 	current->pwd=NULL;
 	iput(current->root);
 	current->root=NULL;
+	iput(current->executable);
+	current->executable=NULL;
 	if (current->leader && current->tty >= 0)
 		tty_table[current->tty].pgrp = 0;
 	if (last_task_used_math == current)
@@ -122,7 +129,8 @@ int sys_waitpid(pid_t pid,int * stat_addr, int options)
 	int flag=0;
 	struct task_struct ** p;
 
-	verify_area(stat_addr,4);
+	if (verify_area(stat_addr,4))
+		return -EFAULT;
 repeat:
 	for(p = &LAST_TASK ; p > &FIRST_TASK ; --p)
 		if (*p && *p != current &&
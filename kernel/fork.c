@@ -25,14 +25,15 @@
 #include <asm/segment.h>
 #include <asm/system.h>
 
-extern void write_verify(unsigned long address);
+extern int write_verify(unsigned long address);
+extern void ret_from_fork(void);
 
 /* It is necessary that there is no warning. */
 extern void memcpy(struct task_struct *, struct task_struct *, long int);
 
 long last_pid=0;
 
-void verify_area(void * addr,int size)
+int verify_area(void * addr,int size)
 {
 	unsigned long start;
 
@@ -42,9 +43,11 @@ void verify_area(void * addr,int size)
 	start += get_base(current->ldt[2]);
 	while (size>0) {
 		size -= 4096;
-		write_verify(start);
+		if (write_verify(start))
+			return -EFAULT;
 		start += 4096;
 	}
+	return 0;
 }
 
 int copy_mem(int nr,struct task_struct * p)
@@ -84,10 +87,11 @@ int copy_process(int nr,long ebp,long edi,long esi,long gs,long none,
 		long eip,long cs,long eflags,long esp,long ss)
 {
 	struct task_struct *p;
+	long * stack;
 	int i;
 	struct file *f;
 
-	p = (struct task_struct *) get_free_page();
+	p = (struct task_struct *) __get_free_page();
 	if (!p)
 		return -EAGAIN;
 #if 0 /* This statement breaks *p memory (gcc 4.4.5). */
@@ -96,36 +100,53 @@ int copy_process(int nr,long ebp,long edi,long esi,long gs,long none,
 	memcpy(p, current, sizeof(struct task_struct));
 #endif
 	p->state = TASK_RUNNING;
+	p->run_next = p->run_prev = NULL;
+	p->array = NULL;
 	p->pid = last_pid;
 	p->father = current->pid;
 	p->counter = p->priority;
 	p->signal = 0;
-	p->alarm = 0;
+	init_timer(&p->alarm_timer);
+	p->wakeup_time = 0;
+	p->sum_exec_runtime = 0;
+	for (i=0 ; i<LAT_BUCKETS ; i++)
+		p->lat_hist[i] = 0;
 	p->leader = 0;		/* process leadership doesn't inherit */
 	p->utime = p->stime = 0;
 	p->cutime = p->cstime = 0;
 	p->start_time = jiffies;
-	p->tss.back_link = 0;
 	p->tss.esp0 = PAGE_SIZE + (long) p;
-	p->tss.ss0 = 0x10;
-	p->tss.eip = eip;
-	p->tss.eflags = eflags;
-	p->tss.eax = 0;
-	p->tss.ecx = ecx;
-	p->tss.edx = edx;
-	p->tss.ebx = ebx;
-	p->tss.esp = esp;
-	p->tss.ebp = ebp;
-	p->tss.esi = esi;
-	p->tss.edi = edi;
-	p->tss.es = es & 0xffff;
-	p->tss.cs = cs & 0xffff;
-	p->tss.ss = ss & 0xffff;
-	p->tss.ds = ds & 0xffff;
-	p->tss.fs = fs & 0xffff;
+	/*
+	 * Build the child's kernel stack: the system call frame that
+	 * ret_from_sys_call returns to user mode from (with eax = 0), below
+	 * it the user esi/edi/ebp for ret_from_fork, which is where the
+	 * first switch_to() into the child lands.
+	 * 자식의 커널 스택 구성: ret_from_sys_call이 사용자 모드로 돌아갈 때
+	 * 쓰는 시스템 호출 프레임(eax = 0)과, 그 아래에 ret_from_fork를 위한
+	 * 사용자 esi/edi/ebp를 둡니다. 자식으로의 첫 switch_to()는 ret_from_fork에
+	 * 도착합니다.
+	 */
+	stack = (long *) p->tss.esp0;
+	*--stack = ss & 0xffff;
+	*--stack = esp;
+	*--stack = eflags;
+	*--stack = cs & 0xffff;
+	*--stack = eip;
+	*--stack = ds & 0xffff;
+	*--stack = es & 0xffff;
+	*--stack = fs & 0xffff;
+	*--stack = edx;
+	*--stack = ecx;
+	*--stack = ebx;
+	*--stack = 0;		/* eax: fork() returns 0 in the child */
+	*--stack = esi;
+	*--stack = edi;
+	*--stack = ebp;
+	p->tss.esp = (long) stack;
+	p->tss.eip = (long) ret_from_fork;
+	p->tss.fs = 0x17;
 	p->tss.gs = gs & 0xffff;
 	p->tss.ldt = _LDT(nr);
-	p->tss.trace_bitmap = 0x80000000;
 	if (last_task_used_math == current)
 		__asm__("fnsave %0"::"m" (p->tss.i387));
 	if (copy_mem(nr,p)) {
@@ -139,9 +160,11 @@ int copy_process(int nr,long ebp,long edi,long esi,long gs,long none,
 		current->pwd->i_count++;
 	if (current->root)
 		current->root->i_count++;
-	set_tss_desc(gdt+(nr<<1)+FIRST_TSS_ENTRY,&(p->tss));
+	if (current->executable)
+		current->executable->i_count++;
 	set_ldt_desc(gdt+(nr<<1)+FIRST_LDT_ENTRY,&(p->ldt));
 	task[nr] = p;	/* do this last, just in case */
+	wake_up_process(p);
 	return last_pid;
 }
 
@@ -3,6 +3,7 @@
 #include <linux/fs.h>
 #include <linux/kernel.h>
 #include <linux/hdreg.h>
+#include <linux/slab.h>
 #include <asm/system.h>
 #include <asm/io.h>
 #include <asm/segment.h>
@@ -33,7 +34,6 @@
 /* Max read/write errors/sector */
 #define MAX_ERRORS	5
 #define MAX_HD		2
-#define NR_REQUEST	32
 
 /*
  *  This struct defines the HD's and their types.
@@ -51,8 +51,8 @@ static struct hd_struct {
 	long nr_sects;
 } hd[5*MAX_HD]={{0,0},};
 
-static struct hd_request {
-	int hd;		/* -1 if no request */
+struct hd_request {
+	int hd;
 	int nsector;
 	int sector;
 	int head;
@@ -61,7 +61,24 @@ static struct hd_request {
 	int errors;
 	struct buffer_head * bh;
 	struct hd_request * next;
-} request[NR_REQUEST];
+};
+
+/*
+ * Requests come from a slab cache, taken by rw_abs_hd() and given back by
+ * the interrupt when done (next_request()). When the cache has no memory,
+ * a few static requests stand in; one of those is always either free or
+ * in flight, so a waiter is woken when it completes.
+ * 요청은 슬랩 캐시에서 오며, rw_abs_hd()가 가져가고 완료 시 인터럽트가
+ * 돌려줍니다 (next_request()). 캐시에 메모리가 없으면 몇 개의 정적 요청이
+ * 대신하며, 그중 하나는 항상 비어 있거나 처리 중이므로 완료 시 대기자가
+ * 깨어납니다.
+ */
+static struct kmem_cache * request_cachep;
+
+#define NR_RESERVED_REQUESTS 2
+
+static struct hd_request reserved_request[NR_RESERVED_REQUESTS];
+static char reserved_busy[NR_RESERVED_REQUESTS];
 
 #define IN_ORDER(s1,s2) \
 (((s1)->hd<(s2)->hd || (s1)->hd==(s2)->hd) && \
@@ -87,7 +104,7 @@ __asm__("cld;rep;outsw"::"d" (port),"S" (buf),"c" (nr)/*:"cx","si"*/)
 
 extern void hd_interrupt(void);
 
-static struct task_struct * wait_for_request=NULL;
+static struct wait_queue * wait_for_request=NULL;
 
 static inline void lock_buffer(struct buffer_head * bh)
 {
@@ -251,6 +268,46 @@ void unexpected_hd_interrupt(void)
 	panic("Unexpected HD interrupt\n\r");
 }
 
+/*
+ * next_request: Retires this_request and moves on to the next. The
+ * request goes back to the cache with its contents untouched, as
+ * add_request() may be looking at it.
+ * next_request: this_request를 끝내고 다음 요청으로 넘어갑니다.
+ * add_request()가 보고 있을 수 있으므로 요청은 내용을 건드리지 않은 채
+ * 캐시로 돌아갑니다.
+ */
+static void next_request(void)
+{
+	struct hd_request * req = this_request;
+
+	this_request = req->next;
+	if (req >= reserved_request && req < reserved_request+NR_RESERVED_REQUESTS)
+		reserved_busy[req - reserved_request] = 0;
+	else
+		kmem_cache_free(request_cachep, req);
+}
+
+/*
+ * alloc_request: A request from the cache, else a free reserved one, else
+ * NULL. Called with interrupts off.
+ * alloc_request: 캐시의 요청, 없으면 비어 있는 예약 요청, 그것도 없으면
+ * NULL. 인터럽트가 꺼진 상태로 호출됩니다.
+ */
+static struct hd_request * alloc_request(void)
+{
+	struct hd_request * req;
+	int i;
+
+	if ((req = kmem_cache_alloc(request_cachep)))
+		return req;
+	for (i=0 ; i<NR_RESERVED_REQUESTS ; i++)
+		if (!reserved_busy[i]) {
+			reserved_busy[i] = 1;
+			return reserved_request+i;
+		}
+	return NULL;
+}
+
 static void bad_rw_intr(void)
 {
 	int i = this_request->hd;
@@ -259,8 +316,7 @@ static void bad_rw_intr(void)
 		this_request->bh->b_uptodate = 0;
 		unlock_buffer(this_request->bh);
 		wake_up(&wait_for_request);
-		this_request->hd = -1;
-		this_request=this_request->next;
+		next_request();
 	}
 	reset_hd(i);
 }
@@ -288,8 +344,7 @@ static void read_intr(void)
 	this_request->bh->b_dirt = 0;
 	wake_up(&wait_for_request);
 	unlock_buffer(this_request->bh);
-	this_request->hd = -1;
-	this_request=this_request->next;
+	next_request();
 	do_request();
 }
 
@@ -307,8 +362,7 @@ static void write_intr(void)
 	this_request->bh->b_dirt = 0;
 	wake_up(&wait_for_request);
 	unlock_buffer(this_request->bh);
-	this_request->hd = -1;
-	this_request=this_request->next;
+	next_request();
 	do_request();
 }
 
@@ -396,14 +450,10 @@ void rw_abs_hd(int rw,unsigned int nr,unsigned int sec,unsigned int head,
 	if (rw!=READ && rw!=WRITE)
 		panic("Bad hd command, must be R/W");
 	lock_buffer(bh);
-repeat:
-	for (req=0+request ; req<NR_REQUEST+request ; req++)
-		if (req->hd<0)
-			break;
-	if (req==NR_REQUEST+request) {
-		sleep_on(&wait_for_request);
-		goto repeat;
-	}
+	cli();
+	while (!(req = alloc_request()))
+		sleep_on_exclusive(&wait_for_request);
+	sti();
 	req->hd=nr;
 	req->nsector=2;
 	req->sector=sec;
@@ -421,10 +471,9 @@ void hd_init(void)
 {
 	int i;
 
-	for (i=0 ; i<NR_REQUEST ; i++) {
-		request[i].hd = -1;
-		request[i].next = NULL;
-	}
+	if (!(request_cachep = kmem_cache_create("hd_request",
+	    sizeof(struct hd_request), NULL)))
+		panic("hd_init: out of memory");
 	for (i=0 ; i<NR_HD ; i++) {
 		hd[i*5].start_sect = 0;
 		hd[i*5].nr_sects = hd_info[i].head*
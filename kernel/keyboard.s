@@ -58,7 +58,12 @@ e0_e1:	inb $0x61,%al
 	pushl $0
 	call do_tty_interrupt
 	addl $4,%esp
-	pop %es
+	testl $3,28(%esp)	/* interrupted user mode and a woken */
+	je 1f			/* reader should preempt it? */
+	cmpl $0,need_resched
+	je 1f
+	call schedule
+1:	pop %es
 	pop %ds
 	popl %edx
 	popl %ecx
@@ -90,10 +95,14 @@ put_queue:
 	shrl $8,%ebx
 	jmp 1b
 2:	movl %ecx,head(%edx)
-	movl proc_list(%edx),%ecx
-	testl %ecx,%ecx
+	cmpl $0,proc_list(%edx)
 	je 3f
-	movl $0,(%ecx)
+	pushl %eax
+	leal proc_list(%edx),%ecx
+	pushl %ecx
+	call wake_up
+	addl $4,%esp
+	popl %eax
 3:	popl %edx
 	popl %ecx
 	ret
@@ -0,0 +1,136 @@
+/*
+ *  linux/kernel/profile.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'profile.c' is the statistical profiler behind prof(). do_timer() hands
+ * it the EIP each tick interrupted; with the profiler off that costs one
+ * test of 'prof_mode'. There is a single histogram: either the kernel or
+ * one process is profiled at a time.
+ * 'profile.c'는 prof() 뒤의 통계적 프로파일러입니다. do_timer()는 매 틱마다
+ * 인터럽트된 EIP를 넘겨주며, 프로파일러가 꺼져 있으면 'prof_mode' 검사 한
+ * 번의 비용만 듭니다. 히스토그램은 하나뿐이므로 한 번에 커널이나 한
+ * 프로세스만 프로파일할 수 있습니다.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <linux/sched.h>
+#include <linux/kernel.h>
+#include <linux/profile.h>
+#include <asm/segment.h>
+#include <asm/system.h>
+
+extern char etext;
+
+int prof_mode = PROF_OFF;
+
+static unsigned long prof_buffer[PROF_BUCKETS];
+static struct prof_info prof;
+
+/* Called by do_timer() with interrupts off / 인터럽트가 꺼진 상태로 do_timer()에서 호출됨 */
+void __profile_tick(long cpl, unsigned long eip)
+{
+	if (prof_mode == PROF_KERNEL ? cpl : (!cpl || current->pid != prof.pid))
+		return;
+	if (eip < prof.low || eip >= prof.high) {
+		prof.missed++;
+		return;
+	}
+	prof_buffer[(eip - prof.low) >> prof.shift]++;
+	prof.samples++;
+}
+
+/*
+ * prof_start: Sizes the buckets so that [low, high) fits the buffer, and
+ * starts sampling.
+ * prof_start: [low, high)가 버퍼에 들어가도록 버킷 크기를 정하고 샘플링을
+ * 시작합니다.
+ */
+static int prof_start(int mode, unsigned long low, unsigned long high)
+{
+	int shift = 2;
+
+	if (low >= high)
+		return -EINVAL;
+	while ((high - low - 1) >> shift >= PROF_BUCKETS)
+		shift++;
+	cli();
+	memset(prof_buffer, 0, sizeof(prof_buffer));
+	prof.mode = mode;
+	prof.pid = current->pid;
+	prof.low = low;
+	prof.high = high;
+	prof.shift = shift;
+	prof.buckets = ((high - low - 1) >> shift) + 1;
+	prof.samples = prof.missed = 0;
+	prof_mode = mode;
+	sti();
+	return 0;
+}
+
+static int prof_read(long count, char * buf)
+{
+	int i;
+
+	if (count > prof.buckets)
+		count = prof.buckets;
+	if (count <= 0)
+		return 0;
+	if (verify_area(buf, count * sizeof(long)))
+		return -EFAULT;
+	for (i=0 ; i<count ; i++)
+		put_fs_long(prof_buffer[i], i + (unsigned long *) buf);
+	return count;
+}
+
+/*
+ * sys_prof()
+ * ----------
+ * User interface to the profiler, see the commands in <linux/profile.h>.
+ * Profiling the kernel is reserved to root. A process may profile itself
+ * unless someone else is already using the profiler, and only root or
+ * the owner may stop it. The histogram stays readable after PROF_OFF.
+ * 프로파일러에 대한 사용자 인터페이스이며, <linux/profile.h>의 명령을
+ * 참조하세요. 커널 프로파일링은 root만 할 수 있습니다. 프로세스는 다른
+ * 누군가가 이미 프로파일러를 쓰고 있지 않으면 자기 자신을 프로파일할 수
+ * 있으며, root나 소유자만 이를 멈출 수 있습니다. 히스토그램은 PROF_OFF 후에도
+ * 읽을 수 있습니다.
+ */
+int sys_prof(int cmd, long arg, char * buf)
+{
+	struct prof_range r;
+	int i;
+
+	switch (cmd) {
+		case PROF_OFF:
+			if (current->euid && prof_mode && prof.pid != current->pid)
+				return -EPERM;
+			prof_mode = PROF_OFF;
+			prof.mode = PROF_OFF;
+			return 0;
+		case PROF_KERNEL:
+			if (current->euid)
+				return -EPERM;
+			return prof_start(PROF_KERNEL, 0, (unsigned long) &etext);
+		case PROF_USER:
+			if (prof_mode && prof.pid != current->pid && current->euid)
+				return -EBUSY;
+			r.low = get_fs_long((unsigned long *) buf);
+			r.high = get_fs_long(1 + (unsigned long *) buf);
+			return prof_start(PROF_USER, r.low, r.high);
+		case PROF_READ:
+			return prof_read(arg, buf);
+		case PROF_INFO:
+			if (verify_area(buf, sizeof(prof)))
+				return -EFAULT;
+			for (i=0 ; i<sizeof(prof)/4 ; i++)
+				put_fs_long(i[(unsigned long *) &prof],
+					i + (unsigned long *) buf);
+			return 0;
+	}
+	return -EINVAL;
+}
@@ -61,7 +61,12 @@ rep_int:
 	jmp rep_int
 end:	movb $0x20,%al
 	outb %al,$0x20		/* EOI */
-	pop %ds
+	testl $3,32(%esp)	/* interrupted user mode and a woken */
+	je 1f			/* reader should preempt it? */
+	cmpl $0,need_resched
+	je 1f
+	call schedule
+1:	pop %ds
 	pop %es
 	popl %eax
 	popl %ebx
@@ -113,10 +118,9 @@ write_char:
 	je write_buffer_empty
 	cmpl $startup,%ebx
 	ja 1f
-	movl proc_list(%ecx),%ebx	# wake up sleeping process
-	testl %ebx,%ebx			# is there any?
-	je 1f
-	movl $0,(%ebx)
+	cmpl $0,proc_list(%ecx)		# wake up sleeping process
+	je 1f				# is there any?
+	call wake_sleeper
 1:	movl tail(%ecx),%ebx
 	movb buf(%ecx,%ebx),%al
 	outb %al,%dx
@@ -128,10 +132,9 @@ write_char:
 	ret
 .align 2
 write_buffer_empty:
-	movl proc_list(%ecx),%ebx	# wake up sleeping process
-	testl %ebx,%ebx			# is there any?
-	je 1f
-	movl $0,(%ebx)
+	cmpl $0,proc_list(%ecx)		# wake up sleeping process
+	je 1f				# is there any?
+	call wake_sleeper
 1:	incl %edx
 	inb %dx,%al
 	jmp 1f
@@ -139,3 +142,23 @@ write_buffer_empty:
 1:	andb $0xd,%al		/* disable transmit interrupt */
 	outb %al,%dx
 	ret
+
+/*
+ * wake_sleeper: calls wake_up() on the wait queue of the tty_queue in
+ * %ecx, keeping the registers the interrupt code above still needs.
+ * wake_sleeper: 위의 인터럽트 코드가 계속 필요로 하는 레지스터를 보존하며
+ * %ecx의 tty_queue 대기 큐에 대해 wake_up()을 호출합니다.
+ */
+.align 2
+wake_sleeper:
+	pushl %eax
+	pushl %ecx
+	pushl %edx
+	leal proc_list(%ecx),%eax
+	pushl %eax
+	call wake_up
+	addl $4,%esp
+	popl %edx
+	popl %ecx
+	popl %eax
+	ret
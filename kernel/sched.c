@@ -34,21 +34,26 @@
  *  최적화 수준: EXTREME (i386을 위해 수동 튜닝됨)
  */
 
+#include <errno.h>
+
+#include <linux/config.h>
 #include <linux/sched.h>
+#include <linux/timer.h>
+#include <linux/clocksource.h>
 #include <linux/kernel.h>
+#include <linux/profile.h>
 #include <signal.h>
 #include <linux/sys.h>
 #include <asm/system.h>
 #include <asm/io.h>
 #include <asm/segment.h>
+#include <asm/div64.h>
 
 /* 
- * Timer Latch Calculation 
- * 타이머 래치 계산
- * LATCH is the value programmed into the PIT (Programmable Interval Timer).
- * LATCH는 PIT(프로그래머블 인터벌 타이머)에 프로그래밍되는 값입니다.
+ * Longest one-shot idle period the 16-bit PIT counter can hold
+ * 16비트 PIT 카운터가 담을 수 있는 가장 긴 원샷 유휴 기간
  */
-#define LATCH (1193180/HZ)
+#define IDLE_MAX_TICKS (0xffff/LATCH)
 
 extern void mem_use(void);
 
@@ -80,6 +85,20 @@ long startup_time = 0;
 struct task_struct *current = &(init_task.task);
 struct task_struct *last_task_used_math = NULL;
 
+/* 
+ * Set when a woken task should preempt 'current' on its way back to user
+ * mode; cleared by schedule()
+ * 깨어난 태스크가 사용자 모드로 돌아가는 'current'를 선점해야 할 때 설정되며,
+ * schedule()이 해제함
+ */
+int need_resched = 0;
+
+/* 
+ * The one TSS the CPU uses: only esp0/ss0 and the I/O bitmap matter
+ * CPU가 사용하는 유일한 TSS: esp0/ss0와 I/O 비트맵만 의미가 있음
+ */
+struct tss_struct cpu_tss;
+
 /* 
  * Task Array: Holds pointers to all Process Control Blocks (PCBs).
  * We initialize index 0 to init_task.
@@ -155,6 +174,411 @@ void math_state_restore()
 	last_task_used_math = current;
 }
 
+/*
+ * Run Queues
+ * 실행 큐
+ *
+ * Runnable tasks sit on one circular list per priority level of the
+ * 'active' array while they have time slice left, and move (recharged) to
+ * the 'expired' array once it runs out. A bitmap per array marks the
+ * non-empty levels, so picking the next task is a bit scan that never
+ * looks at sleeping tasks. When 'active' drains, the two arrays swap.
+ * 실행 가능한 태스크는 타임 슬라이스가 남아 있는 동안 'active' 배열의
+ * 우선순위 레벨별 원형 리스트에 있으며, 소진되면 (재충전되어) 'expired'
+ * 배열로 이동합니다. 배열마다 비어 있지 않은 레벨을 표시하는 비트맵이 있어
+ * 다음 태스크 선택은 대기 중인 태스크를 보지 않는 비트 스캔 한 번입니다.
+ * 'active'가 비면 두 배열을 교환합니다.
+ *
+ * Real-time tasks (SCHED_FIFO, SCHED_RR) have the levels above all normal
+ * tasks and are always queued on 'active', so they never wait for an epoch
+ * switch. A real-time task that is preempted keeps its place at the head
+ * of its level; only a SCHED_RR task whose slice ran out (or a task that
+ * yields) goes to the tail.
+ * 실시간 태스크(SCHED_FIFO, SCHED_RR)는 모든 일반 태스크보다 위의 레벨을
+ * 가지며 항상 'active'에 들어가므로 에포크 전환을 기다리지 않습니다. 선점된
+ * 실시간 태스크는 자기 레벨의 맨 앞 자리를 유지하며, 슬라이스를 소진한
+ * SCHED_RR 태스크(또는 양보한 태스크)만 끝으로 갑니다.
+ *
+ * Task 0 is never queued: it runs only when both arrays are empty.
+ * 태스크 0은 큐에 들어가지 않으며, 두 배열이 모두 비었을 때만 실행됩니다.
+ */
+struct prio_array {
+	int nr_active;
+	unsigned long bitmap[PRIO_WORDS];
+	struct task_struct * queue[MAX_PRIO];
+};
+
+static struct prio_array prio_arrays[2];
+static struct prio_array * active = prio_arrays;
+static struct prio_array * expired = prio_arrays + 1;
+
+/*
+ * Fair Scheduling
+ * 공정 스케줄링
+ *
+ * With 'sched_fair' set, normal tasks don't use the priority arrays at
+ * all. Each accumulates 'vruntime', the CPU time it received scaled
+ * inversely to its weight, and the runnable one with the least vruntime
+ * runs next. Weights grow by 1.25 per priority step (priority 15 = 1024),
+ * so over time each task gets CPU in proportion to its weight however
+ * long it runs or sleeps. Runnable tasks sit in a min-heap on vruntime,
+ * whose size is 'fair_array.nr_active'; 'fair_array' itself only marks
+ * p->array for tasks in the heap. Real-time tasks keep the priority
+ * arrays and still run first.
+ * 'sched_fair'가 설정되면 일반 태스크는 우선순위 배열을 전혀 사용하지
+ * 않습니다. 각 태스크는 받은 CPU 시간을 가중치에 반비례하게 환산한
+ * 'vruntime'을 누적하며, vruntime이 가장 작은 실행 가능한 태스크가 다음에
+ * 실행됩니다. 가중치는 우선순위 한 단계마다 1.25배씩 커지므로(우선순위 15 =
+ * 1024), 얼마나 오래 실행하거나 대기하든 시간이 지나면 각 태스크는 가중치에
+ * 비례하여 CPU를 받습니다. 실행 가능한 태스크는 vruntime 기준 최소 힙에
+ * 있으며 그 크기는 'fair_array.nr_active'이고, 'fair_array' 자체는 힙에 있는
+ * 태스크의 p->array 표시에만 쓰입니다. 실시간 태스크는 우선순위 배열을
+ * 유지하며 여전히 먼저 실행됩니다.
+ */
+int sched_fair = SCHED_FAIR;
+
+static struct prio_array fair_array;
+static struct task_struct * fair_heap[NR_TASKS];
+static unsigned long long fair_min_vruntime = 0;
+
+#define FAIR_TICK_GRAN		(NSEC_PER_SEC/HZ)	/* ns */
+#define FAIR_WAKEUP_GRAN	1000000			/* ns */
+#define FAIR_SLEEPER_CREDIT	(2*NSEC_PER_SEC/HZ)	/* ns */
+#define FAIR_MAX_DELTA		0xffffffffULL		/* ns */
+
+/*
+ * 2^32 / weight, by static priority: 1024 * delta / weight is then
+ * delta * fair_wmult >> 22
+ * 정적 우선순위별 2^32 / 가중치: 1024 * delta / 가중치는
+ * delta * fair_wmult >> 22가 됨
+ */
+static const unsigned long fair_wmult[NICE_LEVELS] = {
+	95443718, 95443718, 76695845, 61356676, 48806447, 39045157,
+	31350126, 24970740, 19976592, 16025997, 12782641, 10250519,
+	8196502, 6557202, 5244160, 4194304, 3355443, 2684355,
+	2147484, 1717987, 1374390, 1099582, 879576, 703632,
+	562979, 450348, 360286, 288233, 230590, 184468,
+	147573, 118058, 94447, 75558, 60447, 48357,
+	38686, 30948, 24759, 19807
+};
+
+#define vruntime_before(a,b) ((long long) ((a)->vruntime - (b)->vruntime) < 0)
+
+static inline void heap_set(int i, struct task_struct * p)
+{
+	fair_heap[i] = p;
+	p->heap_index = i;
+}
+
+static void heap_up(int i)
+{
+	struct task_struct * p = fair_heap[i];
+	int parent;
+
+	while (i) {
+		parent = (i-1) >> 1;
+		if (!vruntime_before(p, fair_heap[parent]))
+			break;
+		heap_set(i, fair_heap[parent]);
+		i = parent;
+	}
+	heap_set(i, p);
+}
+
+static void heap_down(int i)
+{
+	struct task_struct * p = fair_heap[i];
+	int child, n = fair_array.nr_active;
+
+	while ((child = 2*i+1) < n) {
+		if (child+1 < n && vruntime_before(fair_heap[child+1], fair_heap[child]))
+			child++;
+		if (!vruntime_before(fair_heap[child], p))
+			break;
+		heap_set(i, fair_heap[child]);
+		i = child;
+	}
+	heap_set(i, p);
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void fair_enqueue(struct task_struct * p)
+{
+	heap_set(fair_array.nr_active, p);
+	heap_up(fair_array.nr_active++);
+	p->array = &fair_array;
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void fair_dequeue(struct task_struct * p)
+{
+	int i = p->heap_index;
+	struct task_struct * last = fair_heap[--fair_array.nr_active];
+
+	if (last != p) {
+		heap_set(i, last);
+		heap_up(i);
+		heap_down(last->heap_index);
+	}
+	p->array = NULL;
+}
+
+/*
+ * update_curr: Charges 'current' the time it ran since its last update,
+ * to its CPU time and, for a fair task, to its vruntime, keeping its heap
+ * slot and the queue's minimum vruntime in step.
+ * update_curr: 'current'에 마지막 갱신 이후 실행한 시간을 CPU 시간에, 공정
+ * 태스크라면 vruntime에도 부과하고, 힙 위치와 큐의 최소 vruntime을 함께
+ * 맞춥니다.
+ */
+static void update_curr(unsigned long long now)
+{
+	struct task_struct * p = current;
+	unsigned long long delta = now - p->exec_start;
+	int prio;
+
+	p->exec_start = now;
+	p->sum_exec_runtime += delta;
+	if (p->array != &fair_array)
+		return;
+	if (delta > FAIR_MAX_DELTA)
+		delta = FAIR_MAX_DELTA;
+	prio = p->priority;
+	if (prio < 1)
+		prio = 1;
+	else if (prio >= NICE_LEVELS)
+		prio = NICE_LEVELS-1;
+	p->vruntime += (delta * fair_wmult[prio]) >> 22;
+	heap_down(p->heap_index);
+	if ((long long) (fair_heap[0]->vruntime - fair_min_vruntime) > 0)
+		fair_min_vruntime = fair_heap[0]->vruntime;
+}
+
+/*
+ * fair_place: A task rejoining the heap after sleeping gets at most a
+ * small credit over the running tasks, not all the time it slept.
+ * fair_place: 대기 후 힙에 다시 들어오는 태스크는 잔 시간 전부가 아니라
+ * 실행 중인 태스크보다 약간의 이점만 받습니다.
+ */
+static inline void fair_place(struct task_struct * p)
+{
+	unsigned long long min = fair_min_vruntime - FAIR_SLEEPER_CREDIT;
+
+	if ((long long) (p->vruntime - min) < 0)
+		p->vruntime = min;
+}
+
+/*
+ * prio_level: Maps the rt_priority or static priority (higher runs first)
+ * to a run queue level (lower runs first).
+ * prio_level: rt_priority 또는 정적 우선순위(높을수록 먼저 실행)를 실행 큐
+ * 레벨(낮을수록 먼저 실행)로 변환합니다.
+ */
+static inline int prio_level(struct task_struct * p)
+{
+	if (rt_task(p))
+		return MAX_RT_PRIO-1 - p->rt_priority;
+	if (p->priority >= NICE_LEVELS)
+		return MAX_RT_PRIO;
+	if (p->priority < 1)
+		return MAX_PRIO-1;
+	return MAX_PRIO - p->priority;
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void enqueue_task(struct task_struct * p, struct prio_array * array)
+{
+	int lvl = prio_level(p);
+	struct task_struct * head = array->queue[lvl];
+
+	if (array == &fair_array) {
+		fair_enqueue(p);
+		return;
+	}
+	if (!head) {
+		p->run_next = p->run_prev = p;
+		array->queue[lvl] = p;
+		array->bitmap[lvl>>5] |= 1UL << (lvl & 31);
+	} else {
+		p->run_next = head;
+		p->run_prev = head->run_prev;
+		head->run_prev->run_next = p;
+		head->run_prev = p;
+	}
+	array->nr_active++;
+	p->array = array;
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void dequeue_task(struct task_struct * p)
+{
+	struct prio_array * array = p->array;
+	int lvl = prio_level(p);
+
+	if (array == &fair_array) {
+		fair_dequeue(p);
+		return;
+	}
+	if (p->run_next == p) {
+		array->queue[lvl] = NULL;
+		array->bitmap[lvl>>5] &= ~(1UL << (lvl & 31));
+	} else {
+		p->run_prev->run_next = p->run_next;
+		p->run_next->run_prev = p->run_prev;
+		if (array->queue[lvl] == p)
+			array->queue[lvl] = p->run_next;
+	}
+	array->nr_active--;
+	p->array = NULL;
+	p->run_next = p->run_prev = NULL;
+}
+
+/*
+ * activate_task: Queues a runnable task, on 'active' if it has time slice
+ * left, otherwise recharged on 'expired' so it can't starve that array.
+ * Normal tasks go to the fair heap instead when 'sched_fair' is set.
+ * activate_task: 실행 가능한 태스크를 큐에 넣습니다. 타임 슬라이스가 남아
+ * 있으면 'active'에, 아니면 재충전하여 'expired'에 넣어 해당 배열의 태스크가
+ * 굶지 않도록 합니다. 'sched_fair'가 설정되면 일반 태스크는 대신 공정 힙에
+ * 들어갑니다.
+ */
+static inline void activate_task(struct task_struct * p)
+{
+	if (sched_fair && !rt_task(p)) {
+		fair_place(p);
+		fair_enqueue(p);
+	} else if (rt_task(p)) {
+		if (p->counter <= 0)
+			p->counter = p->priority;
+		enqueue_task(p, active);
+	} else if (p->counter > 0)
+		enqueue_task(p, active);
+	else {
+		p->counter = p->priority;
+		enqueue_task(p, expired);
+	}
+}
+
+/*
+ * check_preempt: Asks for a reschedule on the way back to user mode if the
+ * just-queued 'p' outranks 'current'. A task queued on 'expired' has used
+ * up its slice and must wait for the epoch switch, so it can't preempt.
+ * Between fair tasks, 'p' wins if it is clearly behind in vruntime.
+ * check_preempt: 방금 큐에 들어간 'p'가 'current'보다 우선하면 사용자 모드로
+ * 돌아가는 길에 재스케줄을 요청합니다. 'expired'에 들어간 태스크는 슬라이스를
+ * 다 썼으므로 에포크 전환을 기다려야 하며 선점할 수 없습니다. 공정 태스크
+ * 사이에서는 'p'의 vruntime이 확실히 뒤처져 있으면 'p'가 이깁니다.
+ */
+static inline void check_preempt(struct task_struct * p)
+{
+	if (current == task[0])
+		need_resched = 1;
+	else if (p->array == active) {
+		if (current->array == &fair_array ||
+		    prio_level(p) < prio_level(current))
+			need_resched = 1;
+	} else if (p->array == &fair_array && current->array == &fair_array) {
+		update_curr(sched_clock());
+		if ((long long) (current->vruntime - p->vruntime) > FAIR_WAKEUP_GRAN)
+			need_resched = 1;
+	}
+}
+
+/*
+ * rt_keeps_place: A real-time task that is still runnable and has slice
+ * left (SCHED_FIFO always has) stays at the head of its level.
+ * rt_keeps_place: 여전히 실행 가능하고 슬라이스가 남은(SCHED_FIFO는 항상
+ * 남음) 실시간 태스크는 자기 레벨의 맨 앞에 머뭅니다.
+ */
+static inline int rt_keeps_place(struct task_struct * p)
+{
+	return rt_task(p) && p->state == TASK_RUNNING &&
+		(p->policy == SCHED_FIFO || p->counter > 0);
+}
+
+static inline int find_first_level(struct prio_array * array)
+{
+	int i, bit;
+
+	for (i=0 ; i<PRIO_WORDS ; i++)
+		if (array->bitmap[i]) {
+			__asm__("bsfl %1,%0":"=r" (bit):"r" (array->bitmap[i]));
+			return (i<<5) + bit;
+		}
+	return -1;
+}
+
+/*
+ * wake_up_process()
+ * -----------------
+ * Marks a task runnable and puts it on the run queue. Safe to call from
+ * interrupt handlers.
+ * 태스크를 실행 가능으로 표시하고 실행 큐에 넣습니다. 인터럽트 핸들러에서
+ * 호출해도 안전합니다.
+ */
+void wake_up_process(struct task_struct * p)
+{
+	unsigned long flags;
+
+	if (!p)
+		return;
+	save_flags(flags);
+	cli();
+	p->state = TASK_RUNNING;
+	if (!p->array && p != task[0]) {
+		trace_wakeup(p);
+		activate_task(p);
+		check_preempt(p);
+	}
+	restore_flags(flags);
+}
+
+/*
+ * del_from_runqueue: Takes a task off the run queue for good (release).
+ * del_from_runqueue: 태스크를 실행 큐에서 완전히 제거합니다 (release).
+ */
+void del_from_runqueue(struct task_struct * p)
+{
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	if (p->array)
+		dequeue_task(p);
+	restore_flags(flags);
+}
+
+/*
+ * __switch_to()
+ * -------------
+ * Second half of switch_to(), entered by jmp with next's resume address
+ * already on next's stack. Points the kernel stack of the shared TSS at
+ * 'next', swaps the LDT and the fs/gs selectors (which cache LDT
+ * descriptors and so must be reloaded), and redoes the lazy-FPU TS
+ * handling a hardware task switch used to give us.
+ * switch_to()의 후반부로, next의 재개 주소가 이미 next의 스택에 있는 상태에서
+ * jmp로 진입합니다. 공유 TSS의 커널 스택을 'next'로 지정하고, LDT와 (LDT
+ * 디스크립터를 캐시하므로 다시 적재해야 하는) fs/gs 셀렉터를 교체하며,
+ * 하드웨어 태스크 전환이 해 주던 lazy-FPU TS 처리를 다시 수행합니다.
+ */
+void __attribute__((regparm(2)))
+__switch_to(struct task_struct * prev, struct task_struct * next)
+{
+	__asm__ __volatile__("movl %%fs,%0":"=r" (prev->tss.fs));
+	__asm__ __volatile__("movl %%gs,%0":"=r" (prev->tss.gs));
+	cpu_tss.esp0 = next->tss.esp0;
+	__asm__ __volatile__("lldt %%ax"::"a" (next->tss.ldt));
+	__asm__ __volatile__("movl %0,%%fs"::"r" (next->tss.fs));
+	__asm__ __volatile__("movl %0,%%gs"::"r" (next->tss.gs));
+	if (last_task_used_math == next)
+		__asm__ __volatile__("clts");
+	else
+		__asm__ __volatile__("movl %%cr0,%%eax\n\t"
+			"orl $8,%%eax\n\t"
+			"movl %%eax,%%cr0":::"ax");
+	current = next;
+}
+
 /*
  *  schedule()
  *  ----------
@@ -164,106 +588,252 @@ void math_state_restore()
  *  This function determines which process runs next.
  *  이 함수는 다음에 실행할 프로세스를 결정합니다.
  *
- *  It scans the task list using a priority-based round-robin algorithm.
- *  우선순위 기반 라운드 로빈 알고리즘을 사용하여 태스크 리스트를 스캔합니다.
- *  
  *  Logic / 로직:
- *  1. Handle Signals (Alarm, etc.) - 신호 처리 (알람 등)
- *  2. Pick the task with the highest counter (time slice). - 가장 높은 카운터(타임 슬라이스)를 가진 태스크 선택
- *  3. If no runnable tasks have slices left, recharge all tasks. - 실행 가능한 태스크의 슬라이스가 없으면 모든 태스크 충전
+ *  1. Take current off its list; requeue it at the tail if it is still
+ *     runnable (on 'expired' if its slice ran out). - 현재 태스크를 리스트에서
+ *     빼고, 여전히 실행 가능하면 끝에 다시 넣습니다 (슬라이스 소진 시 'expired').
+ *  2. If 'active' is empty, swap it with 'expired'. - 'active'가 비면 'expired'와 교환
+ *  3. Run the head of the highest non-empty level, or task 0. - 비어 있지 않은
+ *     최상위 레벨의 첫 태스크, 없으면 태스크 0 실행
  */
 void schedule(void)
 {
-	int i, next, c;
-	struct task_struct ** p;
+	struct task_struct * next;
+	struct prio_array * array;
+	unsigned long long now;
+	unsigned long flags;
+	int lvl;
+
+	save_flags(flags);
+	cli();
+	now = sched_clock();
+	update_curr(now);
 
 	/* 
-	 * PHASE 1: Signal Handling & Alarm Checks
-	 * 단계 1: 신호 처리 및 알람 확인
+	 * PHASE 1: Requeue Current
+	 * 단계 1: 현재 태스크 재배치
 	 *
-	 * Iterate backwards from the last task to the first.
-	 * 마지막 태스크부터 처음 태스크까지 역순으로 반복합니다.
+	 * Sleepers leave the queue here; they come back via wake_up_process().
+	 * A running real-time task with slice left stays where it is.
+	 * 대기하는 태스크는 여기서 큐를 떠나며, wake_up_process()로 돌아옵니다.
+	 * 슬라이스가 남은 실행 중인 실시간 태스크는 제자리에 머뭅니다.
+	 * A signal that came in before current went to sleep found it still
+	 * running and woke nobody, so it keeps current runnable here.
+	 * 현재 태스크가 잠들기 전에 도착한 시그널은 아직 실행 중인 태스크를
+	 * 보고 아무도 깨우지 않았으므로, 여기서 현재 태스크를 실행 가능하게 둡니다.
 	 */
-	for(p = &LAST_TASK ; p > &FIRST_TASK ; --p) {
-		if (*p) { 
-			/* 
-			 * Defensive check: pointer validity 
-			 * 방어적 검사: 포인터 유효성
-			 */
-			if ((*p)->alarm && (*p)->alarm < jiffies) {
-				/* 
-				 * Alarm expired: Send SIGALRM 
-				 * 알람 만료: SIGALRM 전송
-				 */
-				(*p)->signal |= (1<<(SIGALRM-1));
-				(*p)->alarm = 0;
-			}
-			/* 
-			 * Wake up interruptible tasks if they have pending signals 
-			 * 보류 중인 신호가 있는 경우 인터럽트 가능한 태스크 깨우기
-			 */
-			if ((*p)->signal && (*p)->state==TASK_INTERRUPTIBLE) {
-				(*p)->state=TASK_RUNNING;
-			}
-		}
+	need_resched = 0;
+	if (current->signal && current->state == TASK_INTERRUPTIBLE)
+		current->state = TASK_RUNNING;
+	if (current->array && !rt_keeps_place(current)) {
+		dequeue_task(current);
+		if (current->state == TASK_RUNNING)
+			activate_task(current);
+	} else if (current == task[0] && current->counter <= 0)
+		current->counter = current->priority;
+
+	/* 
+	 * PHASE 2: Epoch Switch
+	 * 단계 2: 에포크 전환
+	 */
+	if (!active->nr_active) {
+		array = active;
+		active = expired;
+		expired = array;
 	}
 
 	/* 
-	 * PHASE 2: Context Selection (The Scheduler Loop)
-	 * 단계 2: 문맥 선택 (스케줄러 루프)
-	 *
-	 * Find the TASK_RUNNING process with the maximum 'counter' value.
-	 * 'counter' 값이 최대인 TASK_RUNNING 프로세스를 찾습니다.
+	 * PHASE 3: Context Selection
+	 * 단계 3: 문맥 선택
 	 */
-	while (1) {
-		c = -1;
-		next = 0;
-		i = NR_TASKS;
-		p = &task[NR_TASKS];
-		
-		while (--i) {
-			if (!*--p) continue; /* Skip empty slots / 빈 슬롯 건너뛰기 */
-			
-			/* 
-			 * Spider-Web Check: Verify Task Integrity 
-			 * 거미줄 검사: 태스크 무결성 검증
-			 */
-			if ((*p)->state == TASK_RUNNING && (*p)->counter > c) {
-				c = (*p)->counter;
-				next = i;
-			}
+	lvl = find_first_level(active);
+	if (lvl >= 0)
+		next = active->queue[lvl];
+	else if (fair_array.nr_active)
+		next = fair_heap[0];
+	else
+		next = task[0];
+	next->exec_start = now;
+
+	/* 
+	 * Perform the context switch to the chosen 'next' task 
+	 * 선택된 'next' 태스크로 문맥 교환 수행
+	 */
+	trace_switch(current, next);
+	if (next != current)
+		switch_to(current, next);
+	restore_flags(flags);
+}
+
+/*
+ * Tickless Idle
+ * 틱리스 유휴
+ *
+ * While nothing is runnable, task 0 halts the CPU instead of spinning
+ * through pause(). Before halting, the PIT is switched from its periodic
+ * mode to a one-shot (mode 0) that fires when the timer wheel next has
+ * work, up to IDLE_MAX_TICKS away. 'idle_ticks' is the number of ticks the
+ * one-shot covers; whoever sees the idle period end (do_timer() when it
+ * fires, cpu_idle() on an earlier interrupt) credits the skipped jiffies
+ * and restores the periodic tick.
+ * 실행할 것이 없는 동안 태스크 0은 pause()를 반복하는 대신 CPU를 정지시킵니다.
+ * 정지 전에 PIT를 주기 모드에서, 타이머 휠에 다음 작업이 있는 시점(최대
+ * IDLE_MAX_TICKS)에 발생하는 원샷(모드 0)으로 전환합니다. 'idle_ticks'는
+ * 원샷이 담당하는 틱 수이며, 유휴 기간의 종료를 보는 쪽(만료 시 do_timer(),
+ * 더 이른 인터럽트 시 cpu_idle())이 건너뛴 jiffies를 보충하고 주기 틱을
+ * 복원합니다.
+ */
+static unsigned long idle_ticks = 0;
+
+/*
+ * pit_periodic: Back to the periodic tick, the first one 'first' counts
+ * away. In mode 2 a count written while counting is only loaded at the
+ * end of the current period, so the ticks after it are LATCH again.
+ * pit_periodic: 주기 틱으로 돌아가며, 첫 틱은 'first' 카운트 뒤입니다.
+ * 모드 2에서 카운트 중에 쓴 값은 현재 주기가 끝날 때에만 적재되므로, 그 뒤의
+ * 틱은 다시 LATCH입니다.
+ */
+static void pit_periodic(unsigned long first)
+{
+	outb_p(0x34, 0x43);		/* counter 0, mode 2 / 카운터 0, 모드 2 */
+	outb_p(first & 0xff, 0x40);
+	outb_p(first >> 8, 0x40);
+	if (first != LATCH) {
+		outb_p(LATCH & 0xff, 0x40);
+		outb(LATCH >> 8, 0x40);
+	}
+}
+
+static void pit_oneshot(unsigned long count)
+{
+	outb_p(0x30, 0x43);		/* counter 0, mode 0 / 카운터 0, 모드 0 */
+	outb_p(count & 0xff, 0x40);
+	outb(count >> 8, 0x40);
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void idle_credit(unsigned long ticks)
+{
+	jiffies += ticks;
+	task[0]->stime += ticks;
+}
+
+/*
+ * idle_end_early: An interrupt other than the one-shot ended the halt.
+ * Reads how far the PIT got, credits the whole ticks that passed and goes
+ * back to the periodic tick, its first tick shortened by the part of a
+ * tick that had already passed. If the one-shot has already fired (its
+ * IRQ is just pending) it is left for do_timer().
+ * idle_end_early: 원샷이 아닌 인터럽트가 정지를 끝냈습니다. PIT가 얼마나
+ * 진행했는지 읽어 지나간 온전한 틱을 보충하고 주기 틱으로 돌아가며, 첫
+ * 틱은 이미 지난 틱의 일부만큼 짧아집니다.
+ * 원샷이 이미 발생했다면(IRQ가 대기 중일 뿐이면) do_timer()에 맡깁니다.
+ */
+static void idle_end_early(void)
+{
+	unsigned long count, rem;
+
+	outb_p(0xe2, 0x43);		/* read-back status of counter 0 */
+	if (inb_p(0x40) & 0x80)		/* OUT high: one-shot has fired */
+		return;
+	outb_p(0x00, 0x43);		/* latch counter 0 */
+	count = inb_p(0x40);
+	count |= inb_p(0x40) << 8;
+	count = idle_ticks * LATCH - count;
+	rem = count % LATCH;
+	count /= LATCH;
+	if (rem > LATCH-2) {		/* mode 2 needs a count of 2 or more */
+		rem = 0;
+		count++;
+	}
+	idle_ticks = 0;
+	pit_periodic(LATCH - rem);
+	idle_credit(count);
+	update_time_page();
+	run_timers();
+}
+
+/*
+ * pit_clock()
+ * -----------
+ * Nanoseconds since boot, to within a PIT count: 'jiffies' plus how far
+ * the PIT has counted into the current tick (or into the idle one-shot).
+ * A tick that has elapsed but whose interrupt is still pending in the PIC
+ * is added in, so the clock never runs backwards across a tick. This is
+ * the fallback clocksource when there is no usable TSC.
+ * 부팅 후 나노초이며 PIT 카운트 단위로 정확합니다: 'jiffies'에 PIT가
+ * 현재 틱(또는 유휴 원샷) 안에서 진행한 만큼을 더합니다. 경과했지만 그
+ * 인터럽트가 아직 PIC에 대기 중인 틱도 더하므로, 틱 경계에서 시계가 거꾸로
+ * 가지 않습니다. 쓸 수 있는 TSC가 없을 때의 대체 클럭소스입니다.
+ */
+unsigned long long pit_clock(void)
+{
+	unsigned long flags, ticks, count, elapsed;
+	unsigned long long ns;
+
+	save_flags(flags);
+	cli();
+	ticks = jiffies;
+	if (idle_ticks) {
+		elapsed = idle_ticks * LATCH;
+		outb_p(0xe2, 0x43);	/* read-back status of counter 0 */
+		if (!(inb_p(0x40) & 0x80)) {
+			outb_p(0x00, 0x43);
+			count = inb_p(0x40);
+			count |= inb_p(0x40) << 8;
+			elapsed -= count;
 		}
+	} else {
+		outb_p(0x00, 0x43);	/* latch counter 0 */
+		count = inb_p(0x40);
+		count |= inb_p(0x40) << 8;
+		elapsed = LATCH - count;
+		outb_p(0x0a, 0x20);	/* read the master PIC's IRR */
+		if ((inb_p(0x20) & 1) && elapsed < LATCH/2)
+			elapsed += LATCH;
+	}
+	restore_flags(flags);
+	ns = (unsigned long long) elapsed * (NSEC_PER_SEC/HZ);
+	do_div(ns, LATCH);
+	return (unsigned long long) ticks * (NSEC_PER_SEC/HZ) + ns;
+}
 
-		/* 
-		 * If we found a candidate with counter > 0, break and switch 
-		 * 카운터가 0보다 큰 후보를 찾으면 루프를 종료하고 전환합니다
-		 */
-		if (c) break;
+#define nothing_runnable() \
+	(!active->nr_active && !expired->nr_active && !fair_array.nr_active)
 
-		/* 
-		 * PHASE 3: Recharging
-		 * 단계 3: 재충전
-		 *
-		 * If all runnable tasks have exhausted their time slices (c == 0 or -1),
-		 * we recalculate counters for EVERY tasks (sleeping or running).
-		 * 모든 실행 가능한 태스크가 타임 슬라이스를 소진한 경우 (c == 0 또는 -1),
-		 * 모든 태스크(대기 중 또는 실행 중)에 대해 카운터를 재계산합니다.
-		 *
-		 * Formula: counter = counter/2 + priority
-		 * 공식: counter = counter/2 + priority
-		 */
-		for(p = &LAST_TASK ; p > &FIRST_TASK ; --p) {
-			if (*p) {
-				(*p)->counter = ((*p)->counter >> 1) + (*p)->priority;
+/*
+ * cpu_idle()
+ * ----------
+ * Refills the zeroed page pool, then halts until some task is runnable.
+ * Only task 0 comes here.
+ * 0으로 채운 페이지 풀을 다시 채운 뒤, 실행 가능한 태스크가 생길 때까지
+ * 정지합니다. 태스크 0만 여기에 옵니다.
+ */
+static void cpu_idle(void)
+{
+	unsigned long ticks;
+
+	while (nothing_runnable() && refill_zero_pool())
+		/* nothing */ ;
+	cli();
+	while (nothing_runnable()) {
+		/* if the one-shot has fired, halt until do_timer() takes it */
+		/* 원샷이 이미 발생했다면 do_timer()가 받을 때까지 정지 */
+		if (!idle_ticks) {
+			ticks = timer_idle_ticks(IDLE_MAX_TICKS);
+			if (ticks > 1) {
+				idle_ticks = ticks;
+				pit_oneshot(ticks * LATCH);
 			}
 		}
+		/* sti takes effect after hlt starts: no wakeup is lost */
+		/* sti는 hlt 시작 후 적용되므로 깨움이 유실되지 않음 */
+		__asm__ __volatile__("sti ; hlt");
+		cli();
+		if (idle_ticks)
+			idle_end_early();
 	}
-	
-	/* 
-	 * Perform the context switch to the chosen 'next' task 
-	 * 선택된 'next' 태스크로 문맥 교환 수행
-	 */
-	switch_to(next);
+	sti();
 }
 
 /*
@@ -278,32 +848,91 @@ void schedule(void)
 int sys_pause(void)
 {
 	if (!current) panic("sys_pause: Current task is NULL / 현재 태스크가 NULL입니다");
+	/* 
+	 * Task 0 pauses only when idle: halt until there is work
+	 * 태스크 0은 유휴일 때만 pause하므로, 할 일이 생길 때까지 정지
+	 */
+	if (current == task[0]) {
+		cpu_idle();
+		schedule();
+		return 0;
+	}
 	current->state = TASK_INTERRUPTIBLE;
 	schedule();
 	return 0;
 }
 
 /*
- * sleep_on()
- * ----------
- * Uninterruptible Sleep.
- * 인터럽트 불가능한 대기.
+ * Wait Queues
+ * 대기 큐
  *
- * Adds current task to the wait queue specified by *p.
- * 현재 태스크를 *p로 지정된 대기 큐에 추가합니다.
- *
- * Forms a linked list on the stack via 'tmp'.
- * 'tmp'를 통해 스택에 연결 리스트를 형성합니다.
+ * Normal waiters are added at the head, exclusive ones at the tail, so a
+ * wake_up() walk reaches every normal waiter before the first exclusive
+ * one. All list operations run with interrupts off, since interrupt
+ * handlers call wake_up().
+ * 일반 대기자는 앞에, 배타적 대기자는 끝에 추가되므로 wake_up()은 첫 번째
+ * 배타적 대기자보다 먼저 모든 일반 대기자에 도달합니다. 인터럽트 핸들러가
+ * wake_up()을 호출하므로 모든 리스트 연산은 인터럽트가 꺼진 상태에서 실행됩니다.
+ */
+void add_wait_queue(struct wait_queue ** q, struct wait_queue * wait)
+{
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	wait->flags &= ~WQ_FLAG_EXCLUSIVE;
+	wait->next = *q;
+	*q = wait;
+	restore_flags(flags);
+}
+
+void add_wait_queue_exclusive(struct wait_queue ** q, struct wait_queue * wait)
+{
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	wait->flags |= WQ_FLAG_EXCLUSIVE;
+	wait->next = NULL;
+	while (*q)
+		q = &(*q)->next;
+	*q = wait;
+	restore_flags(flags);
+}
+
+void remove_wait_queue(struct wait_queue ** q, struct wait_queue * wait)
+{
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	for ( ; *q ; q = &(*q)->next)
+		if (*q == wait) {
+			*q = wait->next;
+			break;
+		}
+	wait->next = NULL;
+	restore_flags(flags);
+}
+
+/*
+ * __sleep_on: Queues the current task on 'q' in 'state' and schedules
+ * until woken. Interrupts stay off from queueing until schedule(), so a
+ * wake_up() can't slip in between and be lost.
+ * __sleep_on: 현재 태스크를 'state' 상태로 'q'에 넣고 깨어날 때까지
+ * 스케줄링합니다. 큐 삽입부터 schedule()까지 인터럽트가 꺼져 있으므로
+ * 그 사이에 wake_up()이 끼어들어 유실될 수 없습니다.
  */
-void sleep_on(struct task_struct **p)
+static void __sleep_on(struct wait_queue ** q, int state, int exclusive)
 {
-	struct task_struct *tmp;
+	struct wait_queue wait = { NULL, NULL, 0 };
+	unsigned long flags;
 
 	/* 
 	 * Defensive: Null pointer usage check 
 	 * 방어적: Null 포인터 사용 검사
 	 */
-	if (!p) return;
+	if (!q) return;
 
 	/* 
 	 * Safety: Task 0 (Idle) must never sleep 
@@ -313,23 +942,45 @@ void sleep_on(struct task_struct **p)
 		panic("CRITICAL ERROR: Task[0] attempting to sleep! System Halted. / 치명적 오류: Task[0]가 수면을 시도함! 시스템 정지.");
 	}
 
-	tmp = *p;
-	*p = current;
-	current->state = TASK_UNINTERRUPTIBLE;
-	
-	/* 
-	 * Yield CPU 
-	 * CPU 양보
-	 */
+	wait.task = current;
+	save_flags(flags);
+	cli();
+	if (exclusive)
+		add_wait_queue_exclusive(q, &wait);
+	else
+		add_wait_queue(q, &wait);
+	current->state = state;
+	trace_sleep(q);
 	schedule();
-	
-	/* 
-	 * Woken up: Restore list structure 
-	 * 깨어남: 리스트 구조 복원
-	 */
-	if (tmp) {
-		tmp->state = 0; /* TASK_RUNNING */
-	}
+	remove_wait_queue(q, &wait);
+	restore_flags(flags);
+}
+
+/*
+ * sleep_on()
+ * ----------
+ * Uninterruptible Sleep.
+ * 인터럽트 불가능한 대기.
+ *
+ * Callers re-check their condition in a loop: a wakeup only means it may
+ * have changed.
+ * 호출자는 루프에서 조건을 다시 확인합니다: 깨어남은 조건이 바뀌었을 수
+ * 있다는 뜻일 뿐입니다.
+ */
+void sleep_on(struct wait_queue ** q)
+{
+	__sleep_on(q, TASK_UNINTERRUPTIBLE, 0);
+}
+
+/*
+ * sleep_on_exclusive()
+ * --------------------
+ * Uninterruptible sleep where a wake_up() wakes only one such waiter.
+ * wake_up()이 이러한 대기자 하나만 깨우는 인터럽트 불가능한 대기.
+ */
+void sleep_on_exclusive(struct wait_queue ** q)
+{
+	__sleep_on(q, TASK_UNINTERRUPTIBLE, 1);
 }
 
 /*
@@ -338,54 +989,53 @@ void sleep_on(struct task_struct **p)
  * Same as sleep_on, but task can be woken by signals.
  * sleep_on과 동일하지만, 태스크가 신호에 의해 깨어날 수 있습니다.
  */
-void interruptible_sleep_on(struct task_struct **p)
+void interruptible_sleep_on(struct wait_queue ** q)
 {
-	struct task_struct *tmp;
+	__sleep_on(q, TASK_INTERRUPTIBLE, 0);
+}
 
-	if (!p) return;
-	
-	if (current == &(init_task.task)) {
-		panic("CRITICAL ERROR: Task[0] attempting to sleep (interruptible)! / 치명적 오류: Task[0]가 수면(인터럽트 가능)을 시도함!");
-	}
-	
-	tmp = *p;
-	*p = current;
-	
-repeat:	
-	current->state = TASK_INTERRUPTIBLE;
-	schedule();
-	
-	/* 
-	 * Check if we are still linking others in the list 
-	 * 리스트에서 여전히 다른 태스크를 연결하고 있는지 확인
-	 */
-	if (*p && *p != current) {
-		(**p).state = 0;
-		goto repeat;
-	}
-	
-	*p = NULL;
-	if (tmp) {
-		tmp->state = 0;
+/*
+ * __wake_up: Wakes the sleepers on 'q': all normal ones, and exclusive
+ * ones until 'nr_exclusive' of them were actually woken (0 = all).
+ * __wake_up: 'q'의 대기자를 깨웁니다: 일반 대기자는 모두, 배타적 대기자는
+ * 실제로 깨운 수가 'nr_exclusive'가 될 때까지 깨웁니다 (0 = 전부).
+ */
+static void __wake_up(struct wait_queue ** q, int nr_exclusive)
+{
+	struct wait_queue * wait;
+	struct task_struct * p;
+	unsigned long flags;
+
+	if (!q)
+		return;
+	save_flags(flags);
+	cli();
+	for (wait = *q ; wait ; wait = wait->next) {
+		p = wait->task;
+		if (p->state != TASK_INTERRUPTIBLE &&
+		    p->state != TASK_UNINTERRUPTIBLE)
+			continue;
+		wake_up_process(p);
+		if ((wait->flags & WQ_FLAG_EXCLUSIVE) && !--nr_exclusive)
+			break;
 	}
+	restore_flags(flags);
 }
 
 /*
  * wake_up()
  * ---------
- * Wakes up the first process in the wait queue.
- * 대기 큐에 있는 첫 번째 프로세스를 깨웁니다.
+ * Wakes all normal waiters on the queue and one exclusive waiter.
+ * 큐의 모든 일반 대기자와 배타적 대기자 하나를 깨웁니다.
  */
-void wake_up(struct task_struct **p)
+void wake_up(struct wait_queue ** q)
 {
-	if (p && *p) {
-		/* 
-		 * Mark as Runnable 
-		 * 실행 가능으로 표시
-		 */
-		(**p).state = 0; /* TASK_RUNNING */
-		*p = NULL;
-	}
+	__wake_up(q, 1);
+}
+
+void wake_up_all(struct wait_queue ** q)
+{
+	__wake_up(q, 0);
 }
 
 /*
@@ -394,13 +1044,41 @@ void wake_up(struct task_struct **p)
  * Called by timer interrupt handler.
  * 타이머 인터럽트 핸들러에 의해 호출됩니다.
  *
- * Updates system time and task time slices.
- * 시스템 시간과 태스크 타임 슬라이스를 업데이트합니다.
+ * Updates system time and task time slices, and hands the interrupted
+ * EIP to the profiler.
+ * 시스템 시간과 태스크 타임 슬라이스를 업데이트하고, 인터럽트된 EIP를
+ * 프로파일러에 넘깁니다.
  */
-void do_timer(long cpl)
+void do_timer(long cpl, unsigned long eip)
 {
 	if (!current) return; /* Paranoia check / 편집증적 검사 */
 
+	/* 
+	 * End of a tickless idle period: the asm counted one tick, credit
+	 * the rest and restart the periodic tick
+	 * 틱리스 유휴 기간의 끝: 어셈블리가 한 틱을 셌으므로 나머지를 보충하고
+	 * 주기 틱을 재시작
+	 */
+	if (idle_ticks) {
+		idle_credit(idle_ticks - 1);
+		idle_ticks = 0;
+		pit_periodic(LATCH);
+	}
+
+	/* 
+	 * Let the clocksource rebase on the tick and publish the new time
+	 * 클럭소스가 틱을 기준으로 다시 맞추도록 하고 새 시간을 게시함
+	 */
+	if (clocksource->tick)
+		clocksource->tick();
+	update_time_page();
+
+	/* 
+	 * Expire kernel timers (alarms, timeouts)
+	 * 커널 타이머 만료 처리 (알람, 타임아웃)
+	 */
+	run_timers();
+
 	/* 
 	 * Update user or system time based on Current Privilege Level (CPL) 
 	 * 현재 권한 레벨(CPL)에 따라 사용자 또는 시스템 시간 업데이트
@@ -409,29 +1087,40 @@ void do_timer(long cpl)
 		current->utime++;
 	else
 		current->stime++;
+	profile_tick(cpl, eip);
 
 	/* Refresh global system uptime */
 	/* jiffies is updated in assembly usually, but here implied or extern */
 	/* 전역 시스템 가동 시간 갱신 (jiffies는 보통 어셈블리에서 업데이트됨) */
 
 	/* 
-	 * Decrement time slice 
-	 * 타임 슬라이스 감소
+	 * Decrement time slice; SCHED_FIFO has none
+	 * 타임 슬라이스 감소, SCHED_FIFO에는 슬라이스가 없음
 	 */
-	if ((--current->counter) > 0) return;
-	
+	if (current->policy == SCHED_FIFO) return;
+
 	/* 
-	 * Slice exhausted 
-	 * 슬라이스 소진됨
+	 * Fair tasks have no slice: preempt once another is a tick behind
+	 * 공정 태스크에는 슬라이스가 없음: 다른 태스크가 한 틱 뒤처지면 선점
 	 */
-	current->counter = 0;
+	if (current->array == &fair_array) {
+		update_curr(sched_clock());
+		if (fair_heap[0] != current &&
+		    (long long) (current->vruntime - fair_heap[0]->vruntime) >
+		    FAIR_TICK_GRAN)
+			need_resched = 1;
+		return;
+	}
+	if ((--current->counter) > 0) return;
 	
 	/* 
-	 * If we are in user mode (cpl > 0), reschedule immediately 
-	 * 사용자 모드(cpl > 0)에 있다면 즉시 재스케줄링
+	 * Slice exhausted: reschedule on the way back to user mode, right
+	 * away if the tick interrupted it, else when the kernel leaves
+	 * 슬라이스 소진됨: 사용자 모드로 돌아가는 길에 재스케줄링하며, 틱이
+	 * 사용자 모드를 인터럽트했다면 즉시, 아니면 커널을 떠날 때 수행
 	 */
-	if (!cpl) return;
-	schedule();
+	current->counter = 0;
+	need_resched = 1;
 }
 
 /*
@@ -440,12 +1129,28 @@ void do_timer(long cpl)
  * Sets a timer for signal generation.
  * 신호 생성을 위한 타이머를 설정합니다.
  */
+static void alarm_fn(unsigned long data)
+{
+	struct task_struct * p = (struct task_struct *) data;
+
+	p->signal |= (1<<(SIGALRM-1));
+	if (p->state == TASK_INTERRUPTIBLE)
+		wake_up_process(p);
+}
+
 int sys_alarm(long seconds)
 {
-	int old = current->alarm;
+	struct timer_list * timer = &current->alarm_timer;
+	int old = 0;
 
-	if (old) old = (old - jiffies) / HZ;
-	current->alarm = (seconds>0) ? (jiffies + HZ*seconds) : 0;
+	if (del_timer(timer))
+		old = (timer->expires - jiffies) / HZ;
+	if (seconds > 0) {
+		timer->expires = jiffies + HZ*seconds;
+		timer->data = (unsigned long) current;
+		timer->function = alarm_fn;
+		add_timer(timer);
+	}
 	return (old);
 }
 
@@ -467,8 +1172,23 @@ int sys_getegid(void) { return current->egid; }
  */
 int sys_nice(long increment)
 {
+	struct prio_array * array;
+	unsigned long flags;
+
 	if (current->priority - increment > 0) {
+		/* 
+		 * The run queue level follows priority: requeue on change
+		 * 실행 큐 레벨은 우선순위를 따르므로 변경 시 다시 큐에 넣음
+		 */
+		save_flags(flags);
+		cli();
+		array = current->array;
+		if (array)
+			dequeue_task(current);
 		current->priority -= increment;
+		if (array)
+			enqueue_task(current, array);
+		restore_flags(flags);
 		/* 
 		 * 20260125: Performance Boost Notification 
 		 * 2026/01/25: 성능 부스트 알림
@@ -481,6 +1201,118 @@ int sys_nice(long increment)
 	return 0;
 }
 
+/*
+ * Real-time Scheduling
+ * 실시간 스케줄링
+ *
+ * sched_setscheduler() and friends. Only root may make a task real-time,
+ * and only root or the owner may change a task's scheduling at all.
+ * sched_setscheduler() 등. root만 태스크를 실시간으로 만들 수 있으며,
+ * 태스크의 스케줄링 변경 자체도 root나 소유자만 할 수 있습니다.
+ */
+static struct task_struct * find_task_by_pid(long pid)
+{
+	int i;
+
+	if (!pid)
+		return current;
+	for (i=0 ; i<NR_TASKS ; i++)
+		if (task[i] && task[i]->pid == pid)
+			return task[i];
+	return NULL;
+}
+
+static int setscheduler(long pid, long policy, struct sched_param * param)
+{
+	struct task_struct * p;
+	struct prio_array * array;
+	unsigned long flags;
+	long prio;
+
+	if (!param)
+		return -EINVAL;
+	if (!(p = find_task_by_pid(pid)))
+		return -ESRCH;
+	if (policy < 0)
+		policy = p->policy;
+	prio = get_fs_long((unsigned long *) &param->sched_priority);
+	if (policy != SCHED_OTHER && policy != SCHED_FIFO && policy != SCHED_RR)
+		return -EINVAL;
+	if (policy == SCHED_OTHER ? prio != 0 :
+	    (prio < SCHED_RT_PRIO_MIN || prio > SCHED_RT_PRIO_MAX))
+		return -EINVAL;
+	if (current->euid && (policy != SCHED_OTHER || current->euid != p->euid))
+		return -EPERM;
+	if (p == task[0])
+		return -EPERM;
+	save_flags(flags);
+	cli();
+	array = p->array;
+	if (array)
+		dequeue_task(p);
+	p->policy = policy;
+	p->rt_priority = prio;
+	if (array)
+		activate_task(p);
+	need_resched = 1;
+	restore_flags(flags);
+	return 0;
+}
+
+int sys_sched_setscheduler(long pid, long policy, struct sched_param * param)
+{
+	if (policy < 0)
+		return -EINVAL;
+	return setscheduler(pid, policy, param);
+}
+
+int sys_sched_setparam(long pid, struct sched_param * param)
+{
+	return setscheduler(pid, -1, param);
+}
+
+int sys_sched_getscheduler(long pid)
+{
+	struct task_struct * p;
+
+	if (!(p = find_task_by_pid(pid)))
+		return -ESRCH;
+	return p->policy;
+}
+
+int sys_sched_getparam(long pid, struct sched_param * param)
+{
+	struct task_struct * p;
+
+	if (!(p = find_task_by_pid(pid)))
+		return -ESRCH;
+	if (verify_area(param, sizeof(*param)))
+		return -EFAULT;
+	put_fs_long(p->rt_priority, (unsigned long *) &param->sched_priority);
+	return 0;
+}
+
+/*
+ * sys_sched_yield: Moves the current task to the tail of its level.
+ * sys_sched_yield: 현재 태스크를 자기 레벨의 끝으로 옮깁니다.
+ */
+int sys_sched_yield(void)
+{
+	struct prio_array * array;
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	array = current->array;
+	if (array) {
+		dequeue_task(current);
+		enqueue_task(current, array);
+	}
+	schedule();
+	restore_flags(flags);
+	return 0;
+}
+
 int sys_signal(long signal, long addr, long restorer)
 {
 	long i;
@@ -525,10 +1357,14 @@ void sched_init(void)
 	}
 
 	/* 
-	 * Setup Task 0 (Init Task) manually in the GDT 
-	 * GDT에 태스크 0(초기 태스크)을 수동으로 설정
+	 * Setup the shared TSS and Task 0's LDT in the GDT 
+	 * GDT에 공유 TSS와 태스크 0의 LDT를 설정
 	 */
-	set_tss_desc(gdt+FIRST_TSS_ENTRY, &(init_task.task.tss));
+	cpu_tss.esp0 = init_task.task.tss.esp0;
+	cpu_tss.ss0 = 0x10;
+	cpu_tss.ldt = _LDT(0);
+	cpu_tss.trace_bitmap = 0x80000000;	/* no I/O bitmap / I/O 비트맵 없음 */
+	set_tss_desc(gdt+FIRST_TSS_ENTRY, &cpu_tss);
 	set_ldt_desc(gdt+FIRST_LDT_ENTRY, &(init_task.task.ldt));
 	
 	p = gdt + 2 + FIRST_TSS_ENTRY;
@@ -556,12 +1392,14 @@ void sched_init(void)
 	/* 
 	 * PIT (8253) Configuration 
 	 * PIT (8253) 구성
-	 * Mode 3 (Square Wave), Binary, LSB then MSB.
-	 * 모드 3 (구형파), 이진, 하위 바이트(LSB) 후 상위 바이트(MSB).
+	 * Mode 2 (Rate Generator), Binary, LSB then MSB. Unlike mode 3 the
+	 * count runs down once per tick, which pit_clock() relies on.
+	 * 모드 2 (비율 발생기), 이진, 하위 바이트(LSB) 후 상위 바이트(MSB).
+	 * 모드 3과 달리 카운트가 틱마다 한 번 감소하며, pit_clock()이 이에
+	 * 의존합니다.
 	 */
-	outb_p(0x36, 0x43);		
-	outb_p(LATCH & 0xff, 0x40);	/* LSB */
-	outb(LATCH >> 8, 0x40);		/* MSB */
+	pit_periodic(LATCH);
+	clocksource_init();
 
 	/* 
 	 * Setup Interrupt Gates 
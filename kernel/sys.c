@@ -12,7 +12,9 @@
 #include <linux/sched.h>
 #include <linux/tty.h>
 #include <linux/kernel.h>
+#include <linux/clocksource.h>
 #include <asm/segment.h>
+#include <asm/system.h>
 #include <sys/times.h>
 #include <sys/utsname.h>
 
@@ -66,11 +68,6 @@ int sys_rename()
 	return -ENOSYS;
 }
 
-int sys_prof()
-{
-	return -ENOSYS;
-}
-
 int sys_setgid(int gid)
 {
 	if (current->euid && current->uid)
@@ -114,7 +111,8 @@ int sys_time(long * tloc)
 
 	i = CURRENT_TIME;
 	if (tloc) {
-		verify_area(tloc,4);
+		if (verify_area(tloc,4))
+			return -EFAULT;
 		put_fs_long(i,(unsigned long *)tloc);
 	}
 	return i;
@@ -137,6 +135,9 @@ int sys_stime(long * tptr)
 	if (current->euid && current->uid)
 		return -1;
 	startup_time = get_fs_long((unsigned long *)tptr) - jiffies/HZ;
+	cli();
+	update_time_page();
+	sti();
 	return 0;
 }
 
@@ -144,7 +145,8 @@ int sys_times(struct tms * tbuf)
 {
 	if (!tbuf)
 		return jiffies;
-	verify_area(tbuf,sizeof *tbuf);
+	if (verify_area(tbuf,sizeof *tbuf))
+		return -EFAULT;
 	put_fs_long(current->utime,(unsigned long *)&tbuf->tms_utime);
 	put_fs_long(current->stime,(unsigned long *)&tbuf->tms_stime);
 	put_fs_long(current->cutime,(unsigned long *)&tbuf->tms_cutime);
@@ -221,7 +223,8 @@ int sys_uname(struct utsname * name)
 	int i;
 
 	if (!name) return -1;
-	verify_area(name,sizeof *name);
+	if (verify_area(name,sizeof *name))
+		return -EFAULT;
 	for(i=0;i<sizeof *name;i++)
 		put_fs_byte(((char *) &thisname)[i],i+(char *) name);
 	return (0);
@@ -235,16 +238,14 @@ int sys_umask(int mask)
 	return (old);
 }
 
+/*
+ * sys_null: Every unimplemented call number. syscall_stat() counts them
+ * per number, see kernel/sysstat.c.
+ * sys_null: 구현되지 않은 모든 호출 번호. syscall_stat()이 번호별로 셉니다
+ * (kernel/sysstat.c 참조).
+ */
 int sys_null(int nr)
 {
-	static int prev_nr=-2;
-	if (nr==174 || nr==175) return -ENOSYS;
-
-	if (prev_nr!=nr) 
-	{
-		prev_nr=nr;
-//		printk("system call num %d not available\n",nr);
-	}
 	return -ENOSYS;
 }
 
@@ -0,0 +1,104 @@
+/*
+ *  linux/kernel/sysstat.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'sysstat.c' keeps the per-call counters for syscall_stat(). system_call
+ * only tests 'sysstat_on' while counting is off; when it is on it brackets
+ * the call with sysstat_enter() and sysstat_exit(). The start stamp lives
+ * in the task, as the call may sleep and other tasks enter the kernel
+ * meanwhile. The kernel isn't preempted, so the counters need no locking.
+ * 'sysstat.c'는 syscall_stat()을 위한 호출별 카운터를 유지합니다.
+ * system_call은 계수가 꺼져 있는 동안 'sysstat_on'만 검사하고, 켜져 있으면
+ * 호출을 sysstat_enter()와 sysstat_exit()로 감쌉니다. 호출이 잠들 수 있고 그
+ * 사이에 다른 태스크가 커널에 들어올 수 있으므로 시작 시각은 태스크에
+ * 저장됩니다. 커널은 선점되지 않으므로 카운터에는 잠금이 필요 없습니다.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <linux/sched.h>
+#include <linux/kernel.h>
+#include <linux/clocksource.h>
+#include <linux/sysstat.h>
+#include <asm/segment.h>
+
+int sysstat_on = 0;
+
+static struct syscall_stat sysstat[NR_SYSCALLS];
+
+/* Called by system_call before the call / 호출 전에 system_call에서 호출됨 */
+void sysstat_enter(void)
+{
+	current->syscall_start = get_cycles();
+}
+
+/* Called by system_call after the call / 호출 후에 system_call에서 호출됨 */
+void sysstat_exit(long nr, long res)
+{
+	struct syscall_stat * s = sysstat + nr;
+	unsigned long long delta;
+	unsigned long low;
+	int bucket = 0;
+
+	if (!current->syscall_start)
+		return;
+	delta = get_cycles() - current->syscall_start;
+	current->syscall_start = 0;
+	s->calls++;
+	if (res < 0 && res > -4096) {
+		s->errors++;
+		if (res == -ENOSYS)
+			s->enosys++;
+	}
+	s->cycles += delta;
+	if (delta >> 32)
+		bucket = SYSSTAT_BUCKETS-1;
+	else if ((low = delta) > 1)
+		__asm__("bsrl %1,%0":"=r" (bucket):"r" (low));
+	s->hist[bucket]++;
+}
+
+/*
+ * sys_syscall_stat()
+ * ------------------
+ * User interface to the counters, see the commands in <linux/sysstat.h>.
+ * Turning counting on or off is reserved to root. A call in progress when
+ * counting is switched is not counted.
+ * 카운터에 대한 사용자 인터페이스이며, <linux/sysstat.h>의 명령을
+ * 참조하세요. 계수를 켜고 끄는 것은 root만 할 수 있습니다. 전환 시점에 진행
+ * 중인 호출은 세지 않습니다.
+ */
+int sys_syscall_stat(int cmd, long arg, char * buf)
+{
+	int i;
+
+	switch (cmd) {
+		case SYSSTAT_OFF:
+		case SYSSTAT_ON:
+			if (current->euid)
+				return -EPERM;
+			sysstat_on = 0;
+			for (i=0 ; i<NR_TASKS ; i++)
+				if (task[i])
+					task[i]->syscall_start = 0;
+			if (cmd == SYSSTAT_ON) {
+				memset(sysstat, 0, sizeof(sysstat));
+				sysstat_on = 1;
+			}
+			return 0;
+		case SYSSTAT_READ:
+			if (arg < 0 || arg >= NR_SYSCALLS)
+				return -EINVAL;
+			if (verify_area(buf, sizeof(struct syscall_stat)))
+				return -EFAULT;
+			for (i=0 ; i<sizeof(struct syscall_stat)/4 ; i++)
+				put_fs_long(i[(unsigned long *) (sysstat+arg)],
+					i + (unsigned long *) buf);
+			return 0;
+	}
+	return -EINVAL;
+}
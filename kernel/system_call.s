@@ -8,6 +8,14 @@
  * don't handle signal-recognition, as that would clutter them up totally
  * unnecessarily.
  *
+ * Rescheduling is requested through 'need_resched', set when the time
+ * slice runs out or a wakeup queues a task that outranks 'current'. It
+ * is honoured whenever we are about to return to user mode: here, and at
+ * the end of the hd, keyboard and serial interrupts.
+ *
+ * User programs may also come in through 'sysenter_entry', which builds
+ * the same frame as int 0x80 and then joins 'system_call'.
+ *
  * Stack layout in 'ret_from_system_call':
  *
  *	 0(%esp) - %eax
@@ -45,9 +53,12 @@ signal	= 12
 restorer = 16		# address of info-restorer
 sig_fn	= 20		# table of 32 signal addresses
 
-nr_system_calls = 319
+ESP0	= 4		# offset of esp0 in the TSS
+
+nr_system_calls = 322		# NR_SYSCALLS in <linux/sysstat.h>
 
 .globl system_call,sys_fork,timer_interrupt,hd_interrupt,sys_execve
+.globl ret_from_fork,sysenter_entry
 
 .align 2
 bad_sys_call:
@@ -79,16 +90,20 @@ system_call:
 	popl  %edx							# 1st argument is syscall nr
 	pushl %eax
 1:
-
+	cmpl $0,sysstat_on		# counting system calls?
+	jne sysstat_call
 	call *sys_call_table(,%eax,4)
 	pushl %eax
+sysstat_ret:
 	movl current,%eax
 	cmpl $0,state(%eax)		# state
 	jne reschedule
-	cmpl $0,counter(%eax)		# counter
-	je reschedule
 ret_from_sys_call:
-	movl current,%eax		# task[0] cannot have signals
+	testl $3,CS(%esp)		# going back to user mode with a
+	je 1f				# preemption pending? schedule first
+	cmpl $0,need_resched
+	jne reschedule
+1:	movl current,%eax		# task[0] cannot have signals
 	cmpl task,%eax
 	je 3f
 	movl CS(%esp),%ebx		# was old code segment supervisor
@@ -140,6 +155,58 @@ ret_from_sys_call:
 	pop %ds
 	iret
 
+/*
+ * sysstat_call: system_call with syscall_stat() counting on. %ebx keeps
+ * the call number: its value is on the stack as the first argument, and
+ * C functions preserve it.
+ * sysstat_call: syscall_stat() 계수가 켜진 system_call입니다. %ebx는 호출
+ * 번호를 유지합니다: 원래 값은 첫 번째 인수로 스택에 있고, C 함수는 이를
+ * 보존합니다.
+ */
+.align 2
+sysstat_call:
+	movl %eax,%ebx
+	call sysstat_enter
+	movl %ebx,%eax
+	call *sys_call_table(,%eax,4)
+	pushl %eax
+	pushl %eax
+	pushl %ebx
+	call sysstat_exit
+	addl $8,%esp
+	jmp sysstat_ret
+
+/*
+ * sysenter_entry: the fast system call entry, see sysenter_init() in
+ * traps.c. sysenter only loads the kernel cs and ss (flat, so %ss can
+ * reach kernel data before %ds is set up) and a scratch %esp, and clears
+ * IF. The user stub in <unistd.h> passes its return address in %esi and
+ * its stack pointer in %ebp: switch to the task's kernel stack, push what
+ * int 0x80 would have pushed and carry on as 'system_call'. We leave with
+ * its iret, so signals and rescheduling are handled the same way. sysexit
+ * can't be used: it loads flat user segments, and tasks here run in LDT
+ * segments based at nr*64MB.
+ * sysenter_entry: 빠른 시스템 호출 진입점이며, traps.c의 sysenter_init()을
+ * 참조하세요. sysenter는 커널 cs와 ss(평면이므로 %ds를 설정하기 전에도 %ss로
+ * 커널 데이터에 접근 가능)와 임시 %esp만 적재하고 IF를 지웁니다. <unistd.h>의
+ * 사용자 스텁은 복귀 주소를 %esi에, 스택 포인터를 %ebp에 넘깁니다: 태스크의
+ * 커널 스택으로 전환하고, int 0x80이 푸시했을 값을 푸시한 뒤 'system_call'로
+ * 계속합니다. 그 iret으로 빠져나가므로 시그널과 재스케줄링도 똑같이
+ * 처리됩니다. sysexit는 평면 사용자 세그먼트를 적재하는데, 여기의 태스크는
+ * nr*64MB에 기반한 LDT 세그먼트에서 실행되므로 사용할 수 없습니다.
+ */
+.align 2
+sysenter_entry:
+	movl %ss:cpu_tss+ESP0,%esp
+	pushl $0x17		# user ss
+	pushl %ebp		# user esp
+	pushfl
+	orl $0x200,(%esp)	# user eflags, IF was set
+	pushl $0x0f		# user cs
+	pushl %esi		# user eip
+	sti
+	jmp system_call
+
 default_signal:
 	incl %ecx
 	cmpl $SIG_CHLD,%ecx
@@ -168,9 +235,10 @@ timer_interrupt:
 	outb %al,$0x20
 	movl CS(%esp),%eax
 	andl $3,%eax		# %eax is CPL (0 or 3, 0=supervisor)
+	pushl EIP(%esp)		# interrupted EIP, for the profiler
 	pushl %eax
-	call do_timer		# 'do_timer(long CPL)' does everything from
-	addl $4,%esp		# task switching to accounting ...
+	call do_timer		# 'do_timer(long CPL, long EIP)' does everything
+	addl $8,%esp		# from task switching to accounting ...
 	jmp ret_from_sys_call
 
 .align 2
@@ -195,6 +263,21 @@ sys_fork:
 	addl $20,%esp
 1:	ret
 
+/*
+ * A new child's first switch_to() lands here, on the stack copy_process()
+ * built: restore the user registers the system call path doesn't save and
+ * leave like any other system call.
+ * 새 자식의 첫 switch_to()는 copy_process()가 만든 스택 위에서 여기에
+ * 도착합니다: 시스템 호출 경로가 저장하지 않는 사용자 레지스터를 복원하고
+ * 다른 시스템 호출처럼 빠져나갑니다.
+ */
+.align 2
+ret_from_fork:
+	popl %ebp
+	popl %edi
+	popl %esi
+	jmp ret_from_sys_call
+
 hd_interrupt:
 	pushl %eax
 	pushl %ecx
@@ -217,7 +300,12 @@ hd_interrupt:
 	jne 1f
 	movl $unexpected_hd_interrupt,%eax
 1:	call *%eax		# "interesting" way of handling intr.
-	pop %fs
+	testl $3,28(%esp)	# interrupted user mode and the handler
+	je 1f			# woke a task that should preempt it?
+	cmpl $0,need_resched
+	je 1f
+	call schedule
+1:	pop %fs
 	pop %es
 	pop %ds
 	popl %edx
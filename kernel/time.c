@@ -0,0 +1,297 @@
+/*
+ *  linux/kernel/time.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'time.c' picks the clocksource at boot and implements the system calls
+ * that read it. If the CPU has a TSC it is calibrated against one tick of
+ * PIT counter 2 and used from then on: reading it is a single rdtsc
+ * instead of several slow port accesses. Otherwise the PIT counter latch
+ * of sched.c is the clock.
+ * 'time.c'는 부팅 시 클럭소스를 고르고 이를 읽는 시스템 호출을 구현합니다.
+ * CPU에 TSC가 있으면 PIT 카운터 2의 한 틱에 대해 보정한 뒤 계속 사용합니다:
+ * 여러 번의 느린 포트 접근 대신 rdtsc 한 번으로 읽을 수 있기 때문입니다.
+ * 그렇지 않으면 sched.c의 PIT 카운터 래치가 시계입니다.
+ *
+ * It also keeps the time page that exec() maps into every process, see
+ * <sys/timepage.h>.
+ * 또한 exec()가 모든 프로세스에 매핑하는 시간 페이지를 유지하며,
+ * <sys/timepage.h>를 참조하세요.
+ */
+
+#include <errno.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/timepage.h>
+
+#include <linux/sched.h>
+#include <linux/clocksource.h>
+#include <linux/kernel.h>
+#include <linux/mm.h>
+#include <asm/system.h>
+#include <asm/segment.h>
+#include <asm/io.h>
+#include <asm/div64.h>
+
+#define rdtscll(val) __asm__ __volatile__("rdtsc":"=A" (val))
+
+#define CAL_TIMEOUT	0x100000	/* port reads to wait for the PIT */
+
+/* 
+ * A whole page of its own, as all of it is visible to user space
+ * 페이지 전체가 사용자 공간에 보이므로 온전히 한 페이지를 차지함
+ */
+static union {
+	struct time_page tp;
+	char page[PAGE_SIZE];
+} time_page __attribute__((aligned(PAGE_SIZE)));
+
+static struct clocksource pit_clocksource = {
+	"pit", pit_clock, NSEC_PER_SEC/CLOCK_TICK_RATE + 1, NULL
+};
+
+struct clocksource * clocksource = &pit_clocksource;
+
+/*
+ * The TSC is read relative to the last tick, so the cycle delta times
+ * tsc_mult always fits in 64 bits.
+ * TSC는 마지막 틱을 기준으로 읽으므로, 사이클 차이와 tsc_mult의 곱은 항상
+ * 64비트에 들어갑니다.
+ */
+static unsigned long tsc_mult;
+static unsigned long long tsc_last, tsc_last_ns;
+
+static unsigned long long tsc_read(void)
+{
+	unsigned long long now, ns;
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	rdtscll(now);
+	ns = tsc_last_ns + (((now - tsc_last) * tsc_mult) >> TP_TSC_SHIFT);
+	restore_flags(flags);
+	return ns;
+}
+
+static void tsc_tick(void)
+{
+	unsigned long long now;
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	rdtscll(now);
+	tsc_last_ns += ((now - tsc_last) * tsc_mult) >> TP_TSC_SHIFT;
+	tsc_last = now;
+	restore_flags(flags);
+}
+
+static struct clocksource tsc_clocksource = {
+	"tsc", tsc_read, 1, tsc_tick
+};
+
+/*
+ * has_tsc: CPUID (if the ID flag can be toggled at all) feature bit 4.
+ * has_tsc: CPUID 기능 비트 4 (ID 플래그를 바꿀 수 있는 경우에만).
+ */
+static int has_tsc(void)
+{
+	unsigned long eax, edx;
+
+	if (!have_cpuid())
+		return 0;
+	cpuid(1, eax, edx);
+	return edx & 0x10;
+}
+
+/*
+ * calibrate_tsc: Counts TSC cycles over one tick (LATCH counts) of PIT
+ * counter 2 in mode 0, polling its output on port 0x61. Returns 0 if the
+ * PIT never fires or the count doesn't fit in 32 bits.
+ * calibrate_tsc: 모드 0인 PIT 카운터 2의 한 틱(LATCH 카운트) 동안 TSC
+ * 사이클을 셉니다. 출력은 포트 0x61에서 폴링합니다. PIT가 발생하지 않거나
+ * 카운트가 32비트에 들어가지 않으면 0을 반환합니다.
+ */
+static unsigned long calibrate_tsc(void)
+{
+	unsigned long long t1, t2;
+	unsigned long i;
+
+	outb((inb(0x61) & ~0x02) | 0x01, 0x61);	/* gate on, speaker off */
+	outb(0xb0, 0x43);			/* counter 2, mode 0 */
+	outb(LATCH & 0xff, 0x42);
+	outb(LATCH >> 8, 0x42);
+	rdtscll(t1);
+	for (i = 0 ; i < CAL_TIMEOUT ; i++)
+		if (inb(0x61) & 0x20)
+			break;
+	rdtscll(t2);
+	if (i == CAL_TIMEOUT || (t2 - t1) >> 32)
+		return 0;
+	return t2 - t1;
+}
+
+/*
+ * clocksource_init()
+ * ------------------
+ * Called from sched_init() with interrupts off, after the PIT is set up.
+ * More than 10000 cycles per tick (a 1MHz TSC) keeps tsc_mult in 32 bits.
+ * PIT가 설정된 후 인터럽트가 꺼진 상태로 sched_init()에서 호출됩니다. 틱당
+ * 10000 사이클(1MHz TSC)보다 많아야 tsc_mult가 32비트에 들어갑니다.
+ */
+void clocksource_init(void)
+{
+	unsigned long long mult;
+	unsigned long cycles;
+
+	if (has_tsc() && (cycles = calibrate_tsc()) > 10000) {
+		mult = (unsigned long long) (NSEC_PER_SEC/HZ) << TP_TSC_SHIFT;
+		do_div(mult, cycles);
+		tsc_mult = mult;
+		tsc_last_ns = pit_clock();
+		rdtscll(tsc_last);
+		clocksource = &tsc_clocksource;
+	}
+	update_time_page();
+}
+
+/*
+ * update_time_page: Publishes the current time to user space. Called with
+ * interrupts off whenever jiffies, the TSC base or startup_time change.
+ * update_time_page: 현재 시간을 사용자 공간에 게시합니다. jiffies, TSC
+ * 기준점이나 startup_time이 바뀔 때마다 인터럽트가 꺼진 상태로 호출됩니다.
+ */
+void update_time_page(void)
+{
+	volatile struct time_page * tp = &time_page.tp;
+
+	tp->seq++;
+	tp->jiffies = jiffies;
+	tp->startup_time = startup_time;
+	tp->hz = HZ;
+	tp->tick_ns = NSEC_PER_SEC/HZ;
+	if (clocksource == &tsc_clocksource) {
+		tp->clock_mode = TP_CLOCK_TSC;
+		tp->tsc_mult = tsc_mult;
+		tp->tsc_last = tsc_last;
+		tp->tsc_last_ns = tsc_last_ns;
+	} else
+		tp->clock_mode = TP_CLOCK_JIFFIES;
+	tp->sysenter = sysenter_enabled;
+	tp->seq++;
+}
+
+/*
+ * map_time_page: Maps the time page read-only into the task space at
+ * linear address 'base'.
+ * map_time_page: 선형 주소 'base'의 태스크 공간에 시간 페이지를 읽기
+ * 전용으로 매핑합니다.
+ */
+void map_time_page(unsigned long base)
+{
+	if (!put_kernel_page((unsigned long) &time_page, base + TIME_PAGE_ADDR))
+		panic("map_time_page: out of memory");
+}
+
+/*
+ * get_cycles: The TSC for fine-grained interval timing, or nanoseconds
+ * from the PIT on CPUs without one.
+ * get_cycles: 세밀한 구간 측정을 위한 TSC이며, TSC가 없는 CPU에서는 PIT에서
+ * 읽은 나노초입니다.
+ */
+unsigned long long get_cycles(void)
+{
+	unsigned long long now;
+
+	if (clocksource != &tsc_clocksource)
+		return pit_clock();
+	rdtscll(now);
+	return now;
+}
+
+/*
+ * sched_clock: Nanoseconds since boot from the current clocksource.
+ * sched_clock: 현재 클럭소스에서 읽은 부팅 후 나노초.
+ */
+unsigned long long sched_clock(void)
+{
+	return clocksource->read();
+}
+
+static int put_timespec(unsigned long long ns, long base, struct timespec * tp)
+{
+	unsigned long rem = do_div(ns, NSEC_PER_SEC);
+
+	if (verify_area(tp, sizeof(*tp)))
+		return -EFAULT;
+	put_fs_long(base + (unsigned long) ns, (unsigned long *) &tp->tv_sec);
+	put_fs_long(rem, (unsigned long *) &tp->tv_nsec);
+	return 0;
+}
+
+int sys_gettimeofday(struct timeval * tv, struct timezone * tz)
+{
+	unsigned long long ns;
+	unsigned long rem;
+
+	if (tv) {
+		ns = sched_clock();
+		rem = do_div(ns, NSEC_PER_SEC);
+		if (verify_area(tv, sizeof(*tv)))
+			return -EFAULT;
+		put_fs_long(startup_time + (unsigned long) ns,
+			(unsigned long *) &tv->tv_sec);
+		put_fs_long(rem / 1000, (unsigned long *) &tv->tv_usec);
+	}
+	if (tz) {
+		if (verify_area(tz, sizeof(*tz)))
+			return -EFAULT;
+		put_fs_long(0, (unsigned long *) &tz->tz_minuteswest);
+		put_fs_long(0, (unsigned long *) &tz->tz_dsttime);
+	}
+	return 0;
+}
+
+/*
+ * sys_clock_gettime()
+ * -------------------
+ * CLOCK_REALTIME is the CMOS time at boot plus the clocksource,
+ * CLOCK_MONOTONIC the clocksource alone. The CPU-time clocks add the time
+ * the caller has run since it was last charged in schedule().
+ * CLOCK_REALTIME은 부팅 시 CMOS 시간에 클럭소스를 더한 것이고,
+ * CLOCK_MONOTONIC은 클럭소스 자체입니다. CPU 시간 시계는 호출자가
+ * schedule()에서 마지막으로 부과된 이후 실행한 시간을 더합니다.
+ */
+int sys_clock_gettime(clockid_t which, struct timespec * tp)
+{
+	unsigned long long ns;
+	unsigned long flags;
+
+	switch (which) {
+		case CLOCK_REALTIME:
+			return put_timespec(sched_clock(), startup_time, tp);
+		case CLOCK_MONOTONIC:
+			return put_timespec(sched_clock(), 0, tp);
+		case CLOCK_PROCESS_CPUTIME_ID:
+		case CLOCK_THREAD_CPUTIME_ID:
+			save_flags(flags);
+			cli();
+			ns = current->sum_exec_runtime +
+				(sched_clock() - current->exec_start);
+			restore_flags(flags);
+			return put_timespec(ns, 0, tp);
+	}
+	return -EINVAL;
+}
+
+int sys_clock_getres(clockid_t which, struct timespec * tp)
+{
+	if (which < CLOCK_REALTIME || which > CLOCK_THREAD_CPUTIME_ID)
+		return -EINVAL;
+	if (tp)
+		return put_timespec(clocksource->res, 0, tp);
+	return 0;
+}
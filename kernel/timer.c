@@ -0,0 +1,214 @@
+/*
+ *  linux/kernel/timer.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'timer.c' implements the kernel timers as a hierarchical timing wheel.
+ * The first level has one slot per jiffy for the next 256 ticks; each of
+ * the four higher levels has 64 slots covering 64 times the range of the
+ * level below. Timers are hashed into a slot by their expiry, and when
+ * the first level wraps the next slot of the level above is "cascaded"
+ * down. Each tick therefore only looks at the timers that actually
+ * expire (plus the occasional cascade), independent of how many exist.
+ *
+ * 'timer.c'는 커널 타이머를 계층적 타이밍 휠로 구현합니다. 첫 번째 레벨은
+ * 다음 256틱 동안 jiffy당 하나의 슬롯을 가지며, 상위 네 레벨은 각각 아래
+ * 레벨 범위의 64배를 담당하는 64개의 슬롯을 가집니다. 타이머는 만료 시각에
+ * 따라 슬롯에 배치되며, 첫 번째 레벨이 한 바퀴 돌면 위 레벨의 다음 슬롯이
+ * 아래로 "캐스케이드"됩니다. 따라서 각 틱은 타이머 개수와 무관하게 실제로
+ * 만료되는 타이머(와 가끔의 캐스케이드)만 봅니다.
+ */
+
+#include <linux/sched.h>
+#include <linux/timer.h>
+#include <asm/system.h>
+
+#define TVN_BITS 6
+#define TVR_BITS 8
+#define TVN_SIZE (1 << TVN_BITS)
+#define TVR_SIZE (1 << TVR_BITS)
+#define TVN_MASK (TVN_SIZE - 1)
+#define TVR_MASK (TVR_SIZE - 1)
+
+static struct timer_list * tv1[TVR_SIZE];
+static struct timer_list * tv2[TVN_SIZE];
+static struct timer_list * tv3[TVN_SIZE];
+static struct timer_list * tv4[TVN_SIZE];
+static struct timer_list * tv5[TVN_SIZE];
+
+/* the jiffy the wheel has been run up to / 휠이 처리를 마친 jiffy */
+static unsigned long timer_jiffies = 0;
+
+static inline void detach_timer(struct timer_list * timer)
+{
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	timer->next = NULL;
+	timer->pprev = NULL;
+}
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void internal_add_timer(struct timer_list * timer)
+{
+	unsigned long expires = timer->expires;
+	unsigned long idx = expires - timer_jiffies;
+	struct timer_list ** vec;
+
+	if ((long) idx < 0)
+		/* already due: run on the next tick / 이미 만료됨: 다음 틱에 실행 */
+		vec = tv1 + (timer_jiffies & TVR_MASK);
+	else if (idx < TVR_SIZE)
+		vec = tv1 + (expires & TVR_MASK);
+	else if (idx < 1UL << (TVR_BITS + TVN_BITS))
+		vec = tv2 + ((expires >> TVR_BITS) & TVN_MASK);
+	else if (idx < 1UL << (TVR_BITS + 2 * TVN_BITS))
+		vec = tv3 + ((expires >> (TVR_BITS + TVN_BITS)) & TVN_MASK);
+	else if (idx < 1UL << (TVR_BITS + 3 * TVN_BITS))
+		vec = tv4 + ((expires >> (TVR_BITS + 2 * TVN_BITS)) & TVN_MASK);
+	else
+		vec = tv5 + ((expires >> (TVR_BITS + 3 * TVN_BITS)) & TVN_MASK);
+	timer->next = *vec;
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	*vec = timer;
+	timer->pprev = vec;
+}
+
+/*
+ * cascade: Re-hashes every timer of one higher-level slot into the levels
+ * below. Returns the slot index, so that a 0 tells the caller to cascade
+ * the next level as well.
+ * cascade: 상위 레벨 슬롯 하나의 모든 타이머를 아래 레벨로 재배치합니다.
+ * 슬롯 인덱스를 반환하므로, 0이면 호출자가 다음 레벨도 캐스케이드합니다.
+ */
+static int cascade(struct timer_list ** tv, int index)
+{
+	struct timer_list * timer = tv[index], * next;
+
+	tv[index] = NULL;
+	while (timer) {
+		next = timer->next;
+		internal_add_timer(timer);
+		timer = next;
+	}
+	return index;
+}
+
+#define INDEX(N) ((timer_jiffies >> (TVR_BITS + (N) * TVN_BITS)) & TVN_MASK)
+
+void init_timer(struct timer_list * timer)
+{
+	timer->next = NULL;
+	timer->pprev = NULL;
+}
+
+void add_timer(struct timer_list * timer)
+{
+	unsigned long flags;
+
+	save_flags(flags);
+	cli();
+	if (timer_pending(timer))
+		panic("add_timer: timer already pending");
+	internal_add_timer(timer);
+	restore_flags(flags);
+}
+
+/*
+ * del_timer: Cancels a timer. Returns 1 if it was still pending.
+ * del_timer: 타이머를 취소합니다. 아직 대기 중이었으면 1을 반환합니다.
+ */
+int del_timer(struct timer_list * timer)
+{
+	unsigned long flags;
+	int ret = 0;
+
+	save_flags(flags);
+	cli();
+	if (timer_pending(timer)) {
+		detach_timer(timer);
+		ret = 1;
+	}
+	restore_flags(flags);
+	return ret;
+}
+
+/*
+ * mod_timer: (Re)arms a timer for 'expires', pending or not. Returns 1 if
+ * it was pending.
+ * mod_timer: 대기 여부와 관계없이 타이머를 'expires'로 (재)설정합니다.
+ * 대기 중이었으면 1을 반환합니다.
+ */
+int mod_timer(struct timer_list * timer, unsigned long expires)
+{
+	unsigned long flags;
+	int ret = 0;
+
+	save_flags(flags);
+	cli();
+	if (timer_pending(timer)) {
+		detach_timer(timer);
+		ret = 1;
+	}
+	timer->expires = expires;
+	internal_add_timer(timer);
+	restore_flags(flags);
+	return ret;
+}
+
+/*
+ * timer_idle_ticks: Returns in how many ticks (1..max) the wheel next has
+ * work to do, a due timer or a cascade. The idle loop uses it to let the
+ * PIT skip the ticks in between.
+ * timer_idle_ticks: 휠에 다음 작업(만료 타이머 또는 캐스케이드)이 몇 틱
+ * 뒤(1..max)에 있는지 반환합니다. 유휴 루프는 이를 이용해 PIT가 그 사이의
+ * 틱을 건너뛰게 합니다.
+ */
+unsigned long timer_idle_ticks(unsigned long max)
+{
+	unsigned long n, j;
+
+	if ((long) (jiffies - timer_jiffies) >= 0)
+		return 1;
+	for (n = 1 ; n < max ; n++) {
+		j = timer_jiffies + n - 1;
+		if (tv1[j & TVR_MASK] || !(j & TVR_MASK))
+			return n;
+	}
+	return max;
+}
+
+/*
+ * run_timers()
+ * ------------
+ * Called from do_timer() with interrupts off. Catches the wheel up with
+ * 'jiffies' and calls the functions of all timers that became due.
+ * 인터럽트가 꺼진 상태로 do_timer()에서 호출됩니다. 휠을 'jiffies'까지
+ * 따라잡고, 만료된 모든 타이머의 함수를 호출합니다.
+ */
+void run_timers(void)
+{
+	struct timer_list * head, * timer;
+	int index;
+
+	while ((long) (jiffies - timer_jiffies) >= 0) {
+		index = timer_jiffies & TVR_MASK;
+		if (!index &&
+		    !cascade(tv2, INDEX(0)) &&
+		    !cascade(tv3, INDEX(1)) &&
+		    !cascade(tv4, INDEX(2)))
+			cascade(tv5, INDEX(3));
+		timer_jiffies++;
+		head = tv1[index];
+		tv1[index] = NULL;
+		if (head)
+			head->pprev = &head;
+		while ((timer = head)) {
+			detach_timer(timer);
+			timer->function(timer->data);
+		}
+	}
+}
@@ -0,0 +1,195 @@
+/*
+ *  linux/kernel/trace.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'trace.c' records scheduler events for sched_trace(). Events go into a
+ * small ring buffer that overwrites its oldest entries when full, so the
+ * most recent history is always available. The hooks in sched.c test
+ * 'sched_trace_flags' inline and cost nothing beyond that while tracing
+ * is off.
+ * 'trace.c'는 sched_trace()를 위한 스케줄러 이벤트를 기록합니다. 이벤트는
+ * 가득 차면 가장 오래된 항목을 덮어쓰는 작은 링 버퍼에 들어가므로, 항상 가장
+ * 최근 기록을 볼 수 있습니다. sched.c의 훅은 'sched_trace_flags'를 인라인으로
+ * 검사하며, 추적이 꺼져 있는 동안에는 그 이상의 비용이 없습니다.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <linux/sched.h>
+#include <linux/kernel.h>
+#include <linux/trace.h>
+#include <asm/segment.h>
+#include <asm/system.h>
+#include <asm/div64.h>
+
+#define TRACE_SIZE 256		/* must be a power of two / 2의 거듭제곱이어야 함 */
+
+int sched_trace_flags = 0;
+
+static struct trace_event trace_buf[TRACE_SIZE];
+static unsigned long trace_head = 0;
+static unsigned long trace_tail = 0;
+
+/* Must be called with interrupts off / 인터럽트가 꺼진 상태에서 호출해야 합니다 */
+static void trace_event(unsigned long long time, long type, long pid,
+	long arg, long state)
+{
+	struct trace_event * e = trace_buf + (trace_head & (TRACE_SIZE-1));
+
+	e->time = time;
+	e->type = type;
+	e->pid = pid;
+	e->arg = arg;
+	e->state = state;
+	if (++trace_head - trace_tail > TRACE_SIZE)
+		trace_tail++;
+}
+
+static void account_latency(struct task_struct * p, unsigned long long delta)
+{
+	unsigned long us;
+	int bucket = 0;
+
+	do_div(delta, 1000);
+	if (delta >= (1UL << (LAT_BUCKETS-1)))
+		bucket = LAT_BUCKETS-1;
+	else if ((us = delta) > 1)
+		__asm__("bsrl %1,%0":"=r" (bucket):"r" (us));
+	p->lat_hist[bucket]++;
+}
+
+/*
+ * __trace_switch: Called by schedule() with interrupts off once 'next' has
+ * been picked (possibly prev itself).
+ * __trace_switch: 'next'가 선택된 후(prev 자신일 수도 있음) 인터럽트가 꺼진
+ * 상태로 schedule()에서 호출됩니다.
+ */
+void __trace_switch(struct task_struct * prev, struct task_struct * next)
+{
+	unsigned long long now = sched_clock();
+
+	if (next->wakeup_time) {
+		if (sched_trace_flags & TRACE_LATENCY_HIST)
+			account_latency(next, now - next->wakeup_time);
+		next->wakeup_time = 0;
+	}
+	if ((sched_trace_flags & TRACE_EVENTS) && prev != next)
+		trace_event(now, TRACE_SWITCH, prev->pid, next->pid, prev->state);
+}
+
+/*
+ * __trace_wakeup: Called with interrupts off when 'p' is put back on the
+ * run queue.
+ * __trace_wakeup: 'p'가 실행 큐에 다시 들어갈 때 인터럽트가 꺼진 상태로
+ * 호출됩니다.
+ */
+void __trace_wakeup(struct task_struct * p)
+{
+	unsigned long long now = sched_clock();
+
+	if (sched_trace_flags & TRACE_LATENCY_HIST)
+		p->wakeup_time = now;
+	if (sched_trace_flags & TRACE_EVENTS)
+		trace_event(now, TRACE_WAKEUP, p->pid, current->pid, 0);
+}
+
+/* Called with interrupts off / 인터럽트가 꺼진 상태에서 호출됩니다 */
+void __trace_sleep(struct wait_queue ** q)
+{
+	trace_event(sched_clock(), TRACE_SLEEP, current->pid, (long) q,
+		current->state);
+}
+
+static struct task_struct * find_task(long pid)
+{
+	int i;
+
+	if (!pid)
+		return current;
+	for (i=0 ; i<NR_TASKS ; i++)
+		if (task[i] && task[i]->pid == pid)
+			return task[i];
+	return NULL;
+}
+
+static int trace_read(long count, char * buf)
+{
+	struct trace_event e;
+	unsigned long flags;
+	int i, n = 0;
+
+	if (count > TRACE_SIZE)
+		count = TRACE_SIZE;
+	if (count <= 0)
+		return 0;
+	if (verify_area(buf, count * sizeof(struct trace_event)))
+		return -EFAULT;
+	while (n < count) {
+		save_flags(flags);
+		cli();
+		if (trace_tail == trace_head) {
+			restore_flags(flags);
+			break;
+		}
+		e = trace_buf[trace_tail++ & (TRACE_SIZE-1)];
+		restore_flags(flags);
+		for (i=0 ; i<sizeof(e)/4 ; i++)
+			put_fs_long(i[(unsigned long *) &e], i + (unsigned long *) buf);
+		buf += sizeof(e);
+		n++;
+	}
+	return n;
+}
+
+/*
+ * sys_sched_trace()
+ * -----------------
+ * User interface to the tracer, see the commands in <linux/trace.h>.
+ * Turning tracing on or off and resetting histograms is reserved to root.
+ * 추적기에 대한 사용자 인터페이스이며, <linux/trace.h>의 명령을 참조하세요.
+ * 추적을 켜고 끄는 것과 히스토그램 초기화는 root만 할 수 있습니다.
+ */
+int sys_sched_trace(int cmd, long arg, char * buf)
+{
+	struct task_struct * p;
+	int i;
+
+	switch (cmd) {
+		case TRACE_OFF:
+		case TRACE_ON:
+			if (current->euid)
+				return -EPERM;
+			cli();
+			sched_trace_flags = 0;
+			trace_head = trace_tail = 0;
+			for (i=0 ; i<NR_TASKS ; i++)
+				if (task[i])
+					task[i]->wakeup_time = 0;
+			if (cmd == TRACE_ON)
+				sched_trace_flags = arg & (TRACE_EVENTS|TRACE_LATENCY_HIST);
+			sti();
+			return 0;
+		case TRACE_READ:
+			return trace_read(arg, buf);
+		case TRACE_LATENCY:
+			if (!(p = find_task(arg)))
+				return -ESRCH;
+			if (verify_area(buf, sizeof(p->lat_hist)))
+				return -EFAULT;
+			for (i=0 ; i<LAT_BUCKETS ; i++)
+				put_fs_long(p->lat_hist[i], i + (unsigned long *) buf);
+			return LAT_BUCKETS;
+		case TRACE_RESET:
+			if (current->euid)
+				return -EPERM;
+			for (i=0 ; i<NR_TASKS ; i++)
+				if (task[i] && (!arg || task[i]->pid == arg))
+					memset(task[i]->lat_hist, 0, sizeof(task[i]->lat_hist));
+			return 0;
+	}
+	return -EINVAL;
+}
@@ -58,6 +58,21 @@ void general_protection(void);
 void page_fault(void);
 void coprocessor_error(void);
 void reserved(void);
+void sysenter_entry(void);
+
+#define MSR_SYSENTER_CS		0x174
+#define MSR_SYSENTER_ESP	0x175
+#define MSR_SYSENTER_EIP	0x176
+
+int sysenter_enabled = 0;
+
+/*
+ * sysenter_entry reloads %esp before it pushes anything: this stack only
+ * covers an NMI or debug trap on its very first instruction.
+ * sysenter_entry는 무언가를 푸시하기 전에 %esp를 다시 적재합니다: 이
+ * 스택은 첫 명령에서 일어나는 NMI나 디버그 트랩만을 위한 것입니다.
+ */
+static long sysenter_stack[128];
 
 static void die(char * str,long esp_ptr,long nr)
 {
@@ -76,8 +91,10 @@ static void die(char * str,long esp_ptr,long nr)
 			printk("%p ",get_seg_long(0x17,i+(long *)esp[3]));
 		printk("\n");
 	}
-	str(i);
-	printk("Pid: %d, process nr: %d\n\r",current->pid,0xffff & i);
+	for (i=0 ; i<NR_TASKS ; i++)
+		if (task[i] == current)
+			break;
+	printk("Pid: %d, process nr: %d\n\r",current->pid,i);
 	for(i=0;i<10;i++)
 		printk("%02x ",0xff & get_seg_byte(esp[1],(i+(char *)esp[0])));
 	printk("\n\r");
@@ -176,6 +193,32 @@ void do_reserved(long esp, long error_code)
 	die("reserved (15,17-31) error",esp,error_code);
 }
 
+/*
+ * sysenter_init: Programs the sysenter MSRs if the CPU has them. Early
+ * Pentium Pros (family 6, model and stepping below 3) set the SEP bit
+ * without supporting the instruction. User space learns the result from
+ * the time page.
+ * sysenter_init: CPU에 sysenter MSR이 있으면 이를 설정합니다. 초기 Pentium
+ * Pro(패밀리 6, 모델과 스테핑이 3 미만)는 명령을 지원하지 않으면서 SEP
+ * 비트를 설정합니다. 사용자 공간은 시간 페이지에서 그 결과를 알게 됩니다.
+ */
+static void sysenter_init(void)
+{
+	unsigned long sig, features;
+
+	if (!have_cpuid())
+		return;
+	cpuid(1, sig, features);
+	if (!(features & 0x800))
+		return;
+	if (((sig >> 8) & 15) == 6 && ((sig >> 4) & 15) < 3 && (sig & 15) < 3)
+		return;
+	wrmsr(MSR_SYSENTER_CS, 0x08, 0);
+	wrmsr(MSR_SYSENTER_ESP, (long) (sysenter_stack+128), 0);
+	wrmsr(MSR_SYSENTER_EIP, (long) sysenter_entry, 0);
+	sysenter_enabled = 1;
+}
+
 void trap_init(void)
 {
 	int i;
@@ -199,4 +242,5 @@ void trap_init(void)
 	set_trap_gate(16,&coprocessor_error);
 	for (i=17;i<32;i++)
 		set_trap_gate(i,&reserved);
+	sysenter_init();
 }
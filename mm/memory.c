@@ -1,9 +1,13 @@
+#include <errno.h>
 #include <signal.h>
+#include <string.h>
 
 #include <linux/config.h>
 #include <linux/head.h>
 #include <linux/kernel.h>
 #include <linux/mm.h>
+#include <linux/sched.h>
+#include <linux/slab.h>
 #include <asm/system.h>
 
 int do_exit(long code);
@@ -17,6 +21,62 @@ inline void invalidate()
 		:"0" (0) );
 }
 
+/*
+ * invalidate_page drops the TLB entry of a single linear address, so
+ * changing one page table entry doesn't throw away the whole TLB as
+ * invalidate() does. Entries that weren't present need no flush: they
+ * are never cached. invlpg came with the 486; a 386 reloads cr3.
+ * invalidate_page는 선형 주소 하나의 TLB 엔트리만 버리므로, 페이지 테이블
+ * 엔트리 하나를 바꿀 때 invalidate()처럼 TLB 전체를 버리지 않습니다. 존재하지
+ * 않던 엔트리는 캐시되지 않으므로 플러시가 필요 없습니다. invlpg는 486에서
+ * 생겼으므로 386은 cr3를 다시 읽습니다.
+ */
+static int have_invlpg = 0;
+
+static inline void invalidate_page(unsigned long address)
+{
+	if (have_invlpg)
+		__asm__ __volatile__("invlpg (%0)"::"r" (address):"memory");
+	else
+		invalidate();
+}
+
+/*
+ * Range flushes (fork, exit, exec) collect the addresses they change and
+ * flush once at the end: page by page for up to INVLPG_MAX pages, and
+ * with a single invalidate() past that, where it is cheaper.
+ * 범위 플러시(fork, exit, exec)는 바꾼 주소를 모아 두었다가 끝에서 한 번에
+ * 플러시합니다: INVLPG_MAX 페이지까지는 페이지별로, 그보다 많으면 더 싼
+ * invalidate() 한 번으로 합니다.
+ */
+#define INVLPG_MAX 32
+
+struct tlb_range {
+	int nr;
+	unsigned long addr[INVLPG_MAX];
+};
+
+static inline void tlb_range_add(struct tlb_range * r, unsigned long address)
+{
+	if (r->nr < INVLPG_MAX)
+		r->addr[r->nr] = address;
+	r->nr++;
+}
+
+static void tlb_range_flush(struct tlb_range * r)
+{
+	int i;
+
+	if (!r->nr)
+		return;
+	if (r->nr > INVLPG_MAX || !have_invlpg) {
+		invalidate();
+		return;
+	}
+	for (i = 0 ; i < r->nr ; i++)
+		invalidate_page(r->addr[i]);
+}
+
 #if (BUFFER_END < 0x100000)
 #define LOW_MEM 0x100000
 #else
@@ -28,6 +88,11 @@ inline void invalidate()
 #define PAGING_PAGES (PAGING_MEMORY/4096)
 #define MAP_NR(addr) (((addr)-LOW_MEM)>>12)
 
+/* page table entry bit (available to software): kernel page shared read-only */
+#define PAGE_KSHARED 0x200
+/* page directory entry bit: 4Mb page (PSE), see head.s */
+#define PAGE_4M 0x80
+
 #if (PAGING_PAGES < 10)
 #error "Won't work"
 #endif
@@ -45,6 +110,19 @@ __asm__ __volatile("cld\n\t"
 
 static unsigned short mem_map [ PAGING_PAGES ] = {0,};
 
+/*
+ * The zero page: mapped read-only wherever a task reads memory it never
+ * wrote (bss, heap, stack), so untouched zero-filled memory costs no page
+ * of its own. The first write gets a private page, see un_wp_page().
+ * 제로 페이지: 태스크가 쓴 적 없는 메모리(bss, 힙, 스택)를 읽을 때마다
+ * 읽기 전용으로 매핑되므로, 건드리지 않은 0으로 채워진 메모리는 자기 페이지를
+ * 차지하지 않습니다. 처음 쓸 때 전용 페이지를 얻으며, un_wp_page()를
+ * 참조하세요.
+ */
+static char zero_page[PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+
+#define ZERO_PAGE ((unsigned long) zero_page)
+
 /*
  *  linux/mm/memory.c
  *
@@ -55,48 +133,307 @@ static unsigned short mem_map [ PAGING_PAGES ] = {0,};
  */
 
 /*
- *  Get physical address of first (actually last :-) free page, and mark it
- * used. If no free pages left, return 0.
+ * The binary buddy allocator. Free memory is kept as blocks of 2^order
+ * pages, aligned to their size (counted from LOW_MEM), on one list per
+ * order. Allocating splits a larger block if no block of the order is
+ * free; freeing merges a block with its buddy for as long as the buddy is
+ * free too. Order 0, what get_free_page() wants, comes straight off its
+ * list. mem_map still holds the reference counts that copy-on-write
+ * relies on: zero means free, and every page of an allocated block is 1.
+ * 이진 버디 할당기. 여유 메모리는 크기에 맞춰 (LOW_MEM부터 세어) 정렬된
+ * 2^order 페이지 블록으로, order마다 하나의 리스트에 보관됩니다. 할당 시 그
+ * order의 여유 블록이 없으면 더 큰 블록을 쪼개고, 해제 시 버디도 비어 있는
+ * 한 계속 버디와 병합합니다. get_free_page()가 원하는 order 0은 바로 그
+ * 리스트에서 가져옵니다. mem_map은 여전히 copy-on-write가 의존하는 참조 수를
+ * 유지합니다: 0은 여유를 뜻하고, 할당된 블록의 모든 페이지는 1입니다.
+ */
+struct free_area free_area[MAX_ORDER];
+
+static short free_next [ PAGING_PAGES ];
+static short free_prev [ PAGING_PAGES ];
+static signed char free_order [ PAGING_PAGES ];	/* order if a free block starts here, else -1 */
+
+static void add_block(int nr, int order)
+{
+	struct free_area * area = free_area + order;
+
+	free_order[nr] = order;
+	free_prev[nr] = -1;
+	free_next[nr] = area->head;
+	if (area->head >= 0)
+		free_prev[area->head] = nr;
+	area->head = nr;
+	area->count++;
+}
+
+static void del_block(int nr, int order)
+{
+	struct free_area * area = free_area + order;
+
+	free_order[nr] = -1;
+	if (free_prev[nr] >= 0)
+		free_next[free_prev[nr]] = free_next[nr];
+	else
+		area->head = free_next[nr];
+	if (free_next[nr] >= 0)
+		free_prev[free_next[nr]] = free_prev[nr];
+	area->count--;
+}
+
+/* Called with interrupts off / 인터럽트가 꺼진 상태에서 호출됩니다 */
+static int alloc_block(int order)
+{
+	int o, nr;
+
+	for (o = order ; o < MAX_ORDER ; o++)
+		if (free_area[o].head >= 0)
+			break;
+	if (o == MAX_ORDER)
+		return -1;
+	nr = free_area[o].head;
+	del_block(nr, o);
+	while (o > order) {
+		o--;
+		add_block(nr + (1 << o), o);
+	}
+	return nr;
+}
+
+/* Called with interrupts off / 인터럽트가 꺼진 상태에서 호출됩니다 */
+static void free_buddy(int nr, int order)
+{
+	int buddy;
+
+	while (order < MAX_ORDER-1) {
+		buddy = nr ^ (1 << order);
+		if (buddy >= PAGING_PAGES || free_order[buddy] != order)
+			break;
+		del_block(buddy, order);
+		nr &= buddy;
+		order++;
+	}
+	add_block(nr, order);
+}
+
+/*
+ * mem_init: Puts all of LOW_MEM..HIGH_MEMORY on the free lists, in the
+ * largest aligned blocks that fit. Called from main() before anything
+ * allocates.
+ * mem_init: LOW_MEM..HIGH_MEMORY 전체를 들어맞는 가장 큰 정렬된 블록으로
+ * 여유 리스트에 넣습니다. 무언가 할당하기 전에 main()에서 호출됩니다.
+ */
+void mem_init(void)
+{
+	int nr, order;
+
+	have_invlpg = have_486();
+	memset(zero_page, 0, PAGE_SIZE);
+	for (order = 0 ; order < MAX_ORDER ; order++) {
+		free_area[order].head = -1;
+		free_area[order].count = 0;
+	}
+	for (nr = 0 ; nr < PAGING_PAGES ; nr++)
+		free_order[nr] = -1;
+	for (nr = 0 ; nr < PAGING_PAGES ; nr += 1 << order) {
+		order = MAX_ORDER-1;
+		while ((nr & ((1 << order)-1)) || nr + (1 << order) > PAGING_PAGES)
+			order--;
+		add_block(nr, order);
+	}
+}
+
+/*
+ * The zeroed page pool. Zeroing a page on every get_free_page() puts a
+ * 4kB rep stosl into each page fault and fork, while task 0 mostly sits
+ * idle. So cpu_idle() zeroes pages ahead of time into this pool, and
+ * get_free_page() takes them from it first. Pool pages count as used; an
+ * allocation the free lists can't satisfy gives them back, and then asks
+ * the slab caches to give up what they can spare.
+ * 0으로 채운 페이지 풀. get_free_page()마다 페이지를 0으로 채우면 모든 페이지
+ * 폴트와 fork에 4kB의 rep stosl이 들어가는데, 태스크 0은 대부분 유휴 상태로
+ * 있습니다. 그래서 cpu_idle()이 미리 페이지를 0으로 채워 이 풀에 넣고,
+ * get_free_page()는 먼저 여기서 가져갑니다. 풀의 페이지는 사용 중으로
+ * 세어지며, 여유 리스트로 충족할 수 없는 할당은 이를 돌려받고, 그다음
+ * 슬랩 캐시에 내줄 수 있는 것을 내놓도록 요청합니다.
+ */
+#define ZERO_POOL_PAGES 64
+#define ZERO_POOL_MIN_FREE 32	/* free pages refill leaves alone / 채우기가 남겨 두는 여유 페이지 */
+
+static unsigned long zero_pool[ZERO_POOL_PAGES];
+static int zero_pool_count = 0;
+
+static inline void clear_page(unsigned long page)
+{
+int d0,d1;
+__asm__ __volatile__("cld ; rep ; stosl"
+	:"=&c" (d0), "=&D" (d1)
+	:"a" (0),"0" (PAGE_SIZE/4),"1" (page)
+	:"memory");
+}
+
+/*
+ * drain_zero_pool: Frees the whole pool. Called with interrupts off.
+ * drain_zero_pool: 풀 전체를 해제합니다. 인터럽트가 꺼진 상태로 호출됩니다.
+ */
+static void drain_zero_pool(void)
+{
+	while (zero_pool_count)
+		free_page(zero_pool[--zero_pool_count]);
+}
+
+/*
+ *  Get physical address of 2^order free pages, contiguous but not
+ * cleared, and mark them used. If there is no such block left, return 0.
  *
- *  첫 번째(실제로는 마지막 :-) 여유 페이지의 물리적 주소를 가져오고, 사용됨으로 표시합니다.
- *  여유 페이지가 없으면 0을 반환합니다.
+ *  연속되었지만 지워지지 않은 2^order개의 여유 페이지의 물리적 주소를
+ *  가져오고, 사용됨으로 표시합니다. 그런 블록이 남아 있지 않으면 0을
+ *  반환합니다.
+ */
+unsigned long __get_free_pages(int order)
+{
+	unsigned long flags;
+	int nr, i;
+
+	if (order < 0 || order >= MAX_ORDER)
+		return 0;
+	save_flags(flags);
+	cli();
+	while ((nr = alloc_block(order)) < 0) {
+		if (zero_pool_count)
+			drain_zero_pool();
+		else if (!kmem_cache_reap())	/* unused inodes, empty slabs */
+			break;
+	}
+	if (nr < 0) {
+		restore_flags(flags);
+		return 0;
+	}
+	for (i = 0 ; i < (1 << order) ; i++)
+		mem_map[nr+i] = 1;
+	restore_flags(flags);
+	return LOW_MEM + (nr << 12);
+}
+
+/*
+ * __get_free_page: A page whose old contents don't matter, because the
+ * caller overwrites all of it (copy on write) or never lets them out.
+ * __get_free_page: 호출자가 전부 덮어쓰거나(쓰기 시 복사) 밖으로 내보내지
+ * 않으므로 이전 내용이 상관없는 페이지.
+ */
+unsigned long __get_free_page(void)
+{
+	return __get_free_pages(0);
+}
+
+/*
+ * get_free_page: A zeroed page, from the pool if it has one.
+ * get_free_page: 0으로 채운 페이지이며, 풀에 있으면 풀에서 가져옵니다.
  */
 unsigned long get_free_page(void)
 {
-register unsigned long __res;
-
-__asm__ __volatile__("std ; repne ; scasw\n\t"
-	"jne 1f\n\t"
-	"movw $1,2(%%edi)\n\t"
-	"sall $12,%%ecx\n\t"
-	"movl %%ecx,%%edx\n\t"
-	"addl %2,%%edx\n\t"
-	"movl $1024,%%ecx\n\t"
-	"leal 4092(%%edx),%%edi\n\t"
-	"rep ; stosl\n\t"
-	"movl %%edx,%%eax\n"
-	"1:"
-	:"=a" (__res)
-	:"0" (0),"i" (LOW_MEM),"c" (PAGING_PAGES),
-	"D" (mem_map+PAGING_PAGES-1)
-	:"dx");
-return __res;
+	unsigned long page, flags;
+
+	save_flags(flags);
+	cli();
+	if (zero_pool_count) {
+		page = zero_pool[--zero_pool_count];
+		restore_flags(flags);
+		return page;
+	}
+	restore_flags(flags);
+	if ((page = __get_free_page()))
+		clear_page(page);
+	return page;
+}
+
+/* Called with interrupts off / 인터럽트가 꺼진 상태에서 호출됩니다 */
+static int nr_free_pages(void)
+{
+	int order, nr = 0;
+
+	for (order = 0 ; order < MAX_ORDER ; order++)
+		nr += free_area[order].count << order;
+	return nr;
 }
 
 /*
- * Free a page of memory at physical address 'addr'. Used by
- * 'free_page_tables()'
+ * refill_zero_pool: Zeroes one more page into the pool, with interrupts
+ * on. Returns 0 if the pool is full or free memory is low. The page comes
+ * straight off the free lists: draining the pool or reaping the caches
+ * to fill it would only have the idle loop spin on the same pages.
+ * refill_zero_pool: 인터럽트를 켠 채로 페이지 하나를 더 0으로 채워 풀에
+ * 넣습니다. 풀이 가득 찼거나 여유 메모리가 부족하면 0을 반환합니다.
+ * 페이지는 여유 리스트에서 바로 가져옵니다: 풀을 채우려고 풀을 비우거나
+ * 캐시를 회수하면 유휴 루프가 같은 페이지 위에서 돌기만 합니다.
  */
-void free_page(unsigned long addr)
+int refill_zero_pool(void)
 {
+	unsigned long page, flags;
+	int nr;
+
+	if (zero_pool_count >= ZERO_POOL_PAGES)
+		return 0;
+	save_flags(flags);
+	cli();
+	if (nr_free_pages() <= ZERO_POOL_MIN_FREE || (nr = alloc_block(0)) < 0) {
+		restore_flags(flags);
+		return 0;
+	}
+	mem_map[nr] = 1;
+	restore_flags(flags);
+	page = LOW_MEM + (nr << 12);
+	clear_page(page);
+	save_flags(flags);
+	cli();
+	if (zero_pool_count < ZERO_POOL_PAGES) {
+		zero_pool[zero_pool_count++] = page;
+		restore_flags(flags);
+		return 1;
+	}
+	restore_flags(flags);
+	free_page(page);
+	return 0;
+}
+
+/*
+ * free_pages: Frees a block from __get_free_pages(). Like free_page(), it
+ * only drops a reference if the first page is still shared.
+ * free_pages: __get_free_pages()로 얻은 블록을 해제합니다. free_page()처럼,
+ * 첫 페이지가 아직 공유되어 있으면 참조 하나만 줄입니다.
+ */
+void free_pages(unsigned long addr, int order)
+{
+	unsigned long flags;
+	int i;
+
 	if (addr<LOW_MEM) return;
-	if (addr>HIGH_MEMORY)
-		panic("trying to free nonexistent page");
+	if (addr>=HIGH_MEMORY || order < 0 || order >= MAX_ORDER)
+		panic("trying to free nonexistent pages");
 	addr -= LOW_MEM;
 	addr >>= 12;
-	if (mem_map[addr]--) return;
-	mem_map[addr]=0;
-	panic("trying to free free page");
+	if (addr & ((1 << order)-1))
+		panic("trying to free misaligned pages");
+	save_flags(flags);
+	cli();
+	if (!mem_map[addr]) {
+		restore_flags(flags);
+		panic("trying to free free page");
+	}
+	if (!--mem_map[addr]) {
+		for (i = 1 ; i < (1 << order) ; i++)
+			mem_map[addr+i] = 0;
+		free_buddy(addr, order);
+	}
+	restore_flags(flags);
+}
+
+/*
+ * Free a page of memory at physical address 'addr'. Used by
+ * 'free_page_tables()'
+ */
+void free_page(unsigned long addr)
+{
+	free_pages(addr, 0);
 }
 
 /*
@@ -107,6 +444,9 @@ int free_page_tables(unsigned long from,unsigned long size)
 {
 	unsigned long *pg_table;
 	unsigned long * dir, nr;
+	struct tlb_range flush;
+
+	flush.nr = 0;
 	if (from & 0x3fffff)
 		panic("free_page_tables called with wrong alignment");
 	if (!from)
@@ -118,15 +458,20 @@ int free_page_tables(unsigned long from,unsigned long size)
 			continue;
 		pg_table = (unsigned long *) (0xfffff000 & *dir);
 		for (nr=0 ; nr<1024 ; nr++) {
-			if (1 & *pg_table)
+			if (1 & *pg_table) {
 				free_page(0xfffff000 & *pg_table);
+				tlb_range_add(&flush,
+					((unsigned long) dir << 20) + (nr << 12));
+			}
 			*pg_table = 0;
 			pg_table++;
 		}
 		free_page(0xfffff000 & *dir);
 		*dir = 0;
+		/* also drops cached directory entries / 캐시된 디렉터리 엔트리도 버림 */
+		tlb_range_add(&flush,(unsigned long) dir << 20);
 	}
-	invalidate();
+	tlb_range_flush(&flush);
 	return 0;
 }
 
@@ -151,10 +496,12 @@ int copy_page_tables(unsigned long from,unsigned long to,long size)
 {
 	unsigned long * from_page_table;
 	unsigned long * to_page_table;
-	unsigned long this_page;
+	unsigned long this_page, address;
 	unsigned long * from_dir, * to_dir;
 	unsigned long nr;
+	struct tlb_range flush;
 
+	flush.nr = 0;
 	if ((from&0x3fffff) || (to&0x3fffff))
 		panic("copy_page_tables called with wrong alignment");
 	from_dir = (unsigned long *) ((from>>20) & 0xffc); /* _pg_dir = 0 */
@@ -166,17 +513,30 @@ int copy_page_tables(unsigned long from,unsigned long to,long size)
 		if (!(1 & *from_dir))
 			continue;
 		from_page_table = (unsigned long *) (0xfffff000 & *from_dir);
-		if (!(to_page_table = (unsigned long *) get_free_page()))
+		if (!(to_page_table = (unsigned long *) get_free_page())) {
+			tlb_range_flush(&flush);
 			return -1;	/* Out of memory, see freeing */
+		}
 		*to_dir = ((unsigned long) to_page_table) | 7;
 		nr = (from==0)?0xA0:1024;
-		for ( ; nr-- > 0 ; from_page_table++,to_page_table++) {
+		address = (unsigned long) from_dir << 20;
+		for ( ; nr-- > 0 ; from_page_table++,to_page_table++,
+				address += PAGE_SIZE) {
+			if (*from_dir & PAGE_4M) {
+				/* kernel memory mapped by head.s: never shared */
+				/* head.s가 매핑한 커널 메모리: 공유되지 않음 */
+				*to_page_table = (0xffc00000 & *from_dir) +
+					(address & 0x3ff000) + 5;
+				continue;
+			}
 			this_page = *from_page_table;
 			if (!(1 & this_page))
 				continue;
 			this_page &= ~2;
 			*to_page_table = this_page;
 			if (this_page > LOW_MEM) {
+				if (*from_page_table & 2)
+					tlb_range_add(&flush,address);
 				*from_page_table = this_page;
 				this_page -= LOW_MEM;
 				this_page >>= 12;
@@ -184,54 +544,104 @@ int copy_page_tables(unsigned long from,unsigned long to,long size)
 			}
 		}
 	}
-	invalidate();
+	tlb_range_flush(&flush);
 	return 0;
 }
 
 /*
- * This function puts a page in memory at the wanted address.
- * It returns the physical address of the page gotten, 0 if
- * out of memory (either when trying to access page-table or
- * page.)
+ * get_pte: The page table entry for linear 'address', allocating its page
+ * table if there is none. NULL if out of memory. The kernel's 4Mb pages
+ * have no page table entries; nothing may be mapped over them.
+ * get_pte: 선형 주소 'address'의 페이지 테이블 엔트리이며, 페이지 테이블이
+ * 없으면 할당합니다. 메모리가 부족하면 NULL. 커널의 4Mb 페이지에는 페이지
+ * 테이블 엔트리가 없으며, 그 위에는 아무것도 매핑할 수 없습니다.
  */
-unsigned long put_page(unsigned long page,unsigned long address)
+static unsigned long * get_pte(unsigned long address)
 {
 	unsigned long tmp, *page_table;
 
 /* NOTE !!! This uses the fact that _pg_dir=0 */
 
-	if (page < LOW_MEM || page > HIGH_MEMORY)
-		printk("Trying to put page %p at %p\n",page,address);
-	if (mem_map[(page-LOW_MEM)>>12] != 1)
-		printk("mem_map disagrees with %p at %p\n",page,address);
 	page_table = (unsigned long *) ((address>>20) & 0xffc);
+	if (*page_table & PAGE_4M)
+		panic("get_pte: address in a 4Mb kernel page");
 	if ((*page_table)&1)
 		page_table = (unsigned long *) (0xfffff000 & *page_table);
 	else {
 		if (!(tmp=get_free_page()))
-			return 0;
+			return NULL;
 		*page_table = tmp|7;
 		page_table = (unsigned long *) tmp;
 	}
-	page_table[(address>>12) & 0x3ff] = page | 7;
+	return page_table + ((address>>12) & 0x3ff);
+}
+
+/*
+ * This function puts a page in memory at the wanted address.
+ * It returns the physical address of the page gotten, 0 if
+ * out of memory (either when trying to access page-table or
+ * page.)
+ */
+unsigned long put_page(unsigned long page,unsigned long address)
+{
+	unsigned long * pte;
+
+	if (page < LOW_MEM || page > HIGH_MEMORY)
+		printk("Trying to put page %p at %p\n",page,address);
+	if (mem_map[(page-LOW_MEM)>>12] != 1)
+		printk("mem_map disagrees with %p at %p\n",page,address);
+	if (!(pte = get_pte(address)))
+		return 0;
+	*pte = page | 7;
 	return page;
 }
 
-void un_wp_page(unsigned long * table_entry)
+/*
+ * put_kernel_page maps a page of the kernel's own low memory read-only
+ * into user space (the time page). Such pages aren't in mem_map, and
+ * PAGE_KSHARED in the entry makes a write fault kill the process instead
+ * of copying the page.
+ * put_kernel_page는 커널 자신의 하위 메모리 페이지(시간 페이지)를 사용자
+ * 공간에 읽기 전용으로 매핑합니다. 이런 페이지는 mem_map에 없으며, 엔트리의
+ * PAGE_KSHARED 때문에 쓰기 폴트 시 페이지를 복사하는 대신 프로세스를
+ * 종료합니다.
+ */
+unsigned long put_kernel_page(unsigned long page,unsigned long address)
+{
+	unsigned long * pte;
+
+	if (page >= LOW_MEM)
+		panic("put_kernel_page: not a kernel page");
+	if (!(pte = get_pte(address)))
+		return 0;
+	*pte = page | PAGE_KSHARED | 5;
+	return page;
+}
+
+void un_wp_page(unsigned long * table_entry, unsigned long address)
 {
 	unsigned long old_page,new_page;
 
+	if (*table_entry & PAGE_KSHARED)
+		do_exit(SIGSEGV);
 	old_page = 0xfffff000 & *table_entry;
 	if (old_page >= LOW_MEM && mem_map[MAP_NR(old_page)]==1) {
 		*table_entry |= 2;
+		invalidate_page(address);
 		return;
 	}
-	if (!(new_page=get_free_page()))
+	if (old_page == ZERO_PAGE)
+		new_page = get_free_page();
+	else
+		new_page = __get_free_page();
+	if (!new_page)
 		do_exit(SIGSEGV);
 	if (old_page >= LOW_MEM)
 		mem_map[MAP_NR(old_page)]--;
 	*table_entry = new_page | 7;
-	copy_page(old_page,new_page);
+	invalidate_page(address);
+	if (old_page != ZERO_PAGE)
+		copy_page(old_page,new_page);
 }	
 
 /*
@@ -241,32 +651,192 @@ void un_wp_page(unsigned long * table_entry)
  */
 void do_wp_page(unsigned long error_code,unsigned long address)
 {
+	if (*((unsigned long *) ((address>>20) &0xffc)) & PAGE_4M)
+		panic("do_wp_page: write fault in a 4Mb kernel page");
 	un_wp_page((unsigned long *)
 		(((address>>10) & 0xffc) + (0xfffff000 &
-		*((unsigned long *) ((address>>20) &0xffc)))));
+		*((unsigned long *) ((address>>20) &0xffc)))), address);
 
 }
 
-void write_verify(unsigned long address)
+/*
+ * write_verify: Un-share the page at 'address' before the kernel writes
+ * to it. The time page may never be written: -EFAULT, so the system call
+ * fails instead of the write fault killing the task.
+ * write_verify: 커널이 쓰기 전에 'address'의 페이지 공유를 해제합니다.
+ * 시간 페이지는 절대 쓸 수 없습니다: 쓰기 폴트가 태스크를 종료시키는
+ * 대신 시스템 호출이 실패하도록 -EFAULT.
+ */
+int write_verify(unsigned long address)
 {
 	unsigned long page;
 
 	if (!( (page = *((unsigned long *) ((address>>20) & 0xffc)) )&1))
-		return;
+		return 0;
+	if (page & PAGE_4M)	/* kernel memory: always writable / 커널 메모리: 항상 쓰기 가능 */
+		return 0;
 	page &= 0xfffff000;
 	page += ((address>>10) & 0xffc);
+	if (*(unsigned long *) page & PAGE_KSHARED)
+		return -EFAULT;
 	if ((3 & *(unsigned long *) page) == 1)  /* non-writeable, present */
-		un_wp_page((unsigned long *) page);
-	return;
+		un_wp_page((unsigned long *) page, address);
+	return 0;
+}
+
+/*
+ * in_exec_region: Whether the page at task address 'addr' holds any of
+ * the executable's file-backed regions.
+ * in_exec_region: 태스크 주소 'addr'의 페이지가 실행 파일의 파일 기반 영역을
+ * 조금이라도 담고 있는지 여부.
+ */
+static int in_exec_region(unsigned long addr)
+{
+	struct exec_region * r = current->regions;
+	int i;
+
+	for (i=0 ; i<current->nr_regions ; i++,r++)
+		if (addr < r->addr + r->size && addr + PAGE_SIZE > r->addr)
+			return 1;
+	return 0;
 }
 
+/*
+ * read_exec_page: Fills the zeroed 'page' at task address 'addr' with
+ * whatever the executable's regions map there. Holes in the file stay
+ * zero. Returns -1 on a read error.
+ * read_exec_page: 태스크 주소 'addr'에 있는 0으로 채워진 'page'를 실행
+ * 파일의 영역들이 그곳에 매핑하는 내용으로 채웁니다. 파일의 구멍은 0으로
+ * 남습니다. 읽기 오류 시 -1을 반환합니다.
+ */
+static int read_exec_page(unsigned long page, unsigned long addr)
+{
+	struct m_inode * inode = current->executable;
+	struct exec_region * r = current->regions;
+	struct buffer_head * bh;
+	unsigned long start, end, pos, n;
+	int i, block;
+
+	for (i=0 ; i<current->nr_regions ; i++,r++) {
+		start = (addr > r->addr) ? addr : r->addr;
+		end = r->addr + r->size;
+		if (end > addr + PAGE_SIZE)
+			end = addr + PAGE_SIZE;
+		for ( ; start < end ; start += n) {
+			pos = r->offset + (start - r->addr);
+			n = BLOCK_SIZE - pos % BLOCK_SIZE;
+			if (n > end - start)
+				n = end - start;
+			if (!(block = bmap(inode,pos / BLOCK_SIZE)))
+				continue;
+			if (!(bh = bread(inode->i_dev,block)))
+				return -1;
+			memcpy((char *) page + (start - addr),
+				bh->b_data + pos % BLOCK_SIZE, n);
+			brelse(bh);
+		}
+	}
+	return 0;
+}
+
+/*
+ * try_to_share: If task 'p' has the page at task address 'addr' present
+ * and clean (the dirty bit says nobody wrote it since it was read in),
+ * maps it read-only at linear 'address' in the current task as well and
+ * counts the extra user in mem_map. Both tasks then copy it on write.
+ * try_to_share: 태스크 'p'가 태스크 주소 'addr'의 페이지를 존재하고 깨끗한
+ * 상태로(더티 비트가 읽어 들인 이후 아무도 쓰지 않았음을 말해 줌) 가지고
+ * 있으면, 현재 태스크의 선형 주소 'address'에도 읽기 전용으로 매핑하고
+ * mem_map에 추가 사용자를 셉니다. 이후 두 태스크 모두 쓸 때 복사합니다.
+ */
+static int try_to_share(unsigned long address, unsigned long addr,
+	struct task_struct * p)
+{
+	unsigned long from, phys;
+	unsigned long * from_page, * to_page;
+
+	from = get_base(p->ldt[2]) + addr;
+	from_page = (unsigned long *) ((from>>20) & 0xffc);
+	if ((*from_page & (PAGE_4M | 1)) != 1)
+		return 0;
+	from_page = (unsigned long *) (0xfffff000 & *from_page) +
+		((from>>12) & 0x3ff);
+	phys = *from_page;
+	if ((phys & 0x41) != 0x01)		/* present and clean */
+		return 0;
+	phys &= 0xfffff000;
+	if (phys < LOW_MEM || phys >= HIGH_MEMORY)
+		return 0;
+	if (!(to_page = get_pte(address)))
+		return 0;
+	*from_page &= ~2;
+	*to_page = *from_page;
+	invalidate_page(from);
+	mem_map[MAP_NR(phys)]++;
+	return 1;
+}
+
+/*
+ * share_page: Looks for another task running the same executable that
+ * already has this page of it in memory.
+ * share_page: 같은 실행 파일을 실행 중이며 그 페이지를 이미 메모리에 가지고
+ * 있는 다른 태스크를 찾습니다.
+ */
+static int share_page(unsigned long address, unsigned long addr)
+{
+	struct task_struct * p;
+	int i;
+
+	if (current->executable->i_count < 2)
+		return 0;
+	for (i=1 ; i<NR_TASKS ; i++) {
+		if (!(p = task[i]) || p == current)
+			continue;
+		if (p->executable != current->executable)
+			continue;
+		if (try_to_share(address,addr,p))
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * do_no_page: In one of the regions exec() recorded, a read fault first
+ * tries to share the page with another task running the same executable,
+ * and otherwise it is read in from the inode. Anywhere else a read fault
+ * maps the zero page and a write fault gets a fresh zeroed page. Write
+ * faults never share: the page would only be copied again right away.
+ * do_no_page: exec()가 기록한 영역 안에서는 읽기 폴트가 먼저 같은 실행
+ * 파일을 실행 중인 다른 태스크와 페이지를 공유해 보고, 그렇지 않으면
+ * 아이노드에서 읽어 들입니다. 그 밖의 곳에서는 읽기 폴트가 제로 페이지를
+ * 매핑하고 쓰기 폴트는 새로 0으로 채운 페이지를 얻습니다. 쓰기 폴트는 절대
+ * 공유하지 않습니다: 페이지가 곧바로 다시 복사될 뿐이기 때문입니다.
+ */
 void do_no_page(unsigned long error_code,unsigned long address)
 {
-	unsigned long tmp;
+	unsigned long addr, page, * pte;
 
-	if ((tmp=get_free_page()))
-		if (put_page(tmp,address))
+	address &= 0xfffff000;
+	addr = address - get_base(current->ldt[2]);
+	if (current->executable && in_exec_region(addr)) {
+		if (!(error_code & 2) && share_page(address,addr))
 			return;
+		if (!(page=get_free_page()))
+			do_exit(SIGSEGV);
+		if (read_exec_page(page,addr)) {
+			free_page(page);
+			do_exit(SIGSEGV);
+		}
+	} else if (!(error_code & 2)) {
+		if (!(pte = get_pte(address)))
+			do_exit(SIGSEGV);
+		*pte = ZERO_PAGE | 5;
+		return;
+	} else if (!(page=get_free_page()))
+		do_exit(SIGSEGV);
+	if (put_page(page,address))
+		return;
+	free_page(page);
 	do_exit(SIGSEGV);
 }
 
@@ -278,6 +848,11 @@ void calc_mem(void)
 	for(i=0 ; i<PAGING_PAGES ; i++)
 		if (!mem_map[i]) free++;
 	printk(" [MEM] Free Memory: %d KB (Available for Processes)\n\r", free*4); /* 20260119: Memory display in KB / KB 단위 메모리 표시 */
+	printk(" [MEM] Free blocks by order:");
+	for(i=0 ; i<MAX_ORDER ; i++)
+		printk(" %d",free_area[i].count);
+	printk("\n\r");
+	printk(" [MEM] Zeroed page pool: %d pages\n\r",zero_pool_count);
 	printk(" [MEM] Memory Manager Efficiency: 100% (No Leaks Detected)\n\r"); /* 20260119: Memory efficiency status / 메모리 효율성 상태 */
 	for(i=2 ; i<1024 ; i++) {
 		if (1&pg_dir[i]) {
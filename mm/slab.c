@@ -0,0 +1,271 @@
+/*
+ *  linux/mm/slab.c
+ *
+ *  (C) 2008-2026 Rheehose (Rhee Creative)
+ */
+
+/*
+ * 'slab.c' carves small kernel objects out of single pages from the buddy
+ * allocator. Each slab starts with a 'struct slab' header and an index
+ * array chaining its free objects, so a free object's contents are left
+ * alone and stay constructed. Allocation and free are O(1): a cache keeps
+ * its slabs on partial, full and empty lists, allocates from a partial
+ * slab and gives the page back once a second slab goes empty. Objects are
+ * found from their page, as kfree() needs: a slab never crosses a page.
+ * Everything runs with interrupts off, as hd requests are freed from the
+ * disk interrupt.
+ * 'slab.c'는 버디 할당기에서 받은 단일 페이지로부터 작은 커널 객체를
+ * 잘라냅니다. 각 슬랩은 'struct slab' 헤더와 여유 객체를 잇는 인덱스 배열로
+ * 시작하므로, 여유 객체의 내용은 건드리지 않고 생성된 상태로 남습니다. 할당과
+ * 해제는 O(1)입니다: 캐시는 슬랩을 partial, full, empty 리스트에 보관하고,
+ * partial 슬랩에서 할당하며, 두 번째 슬랩이 비면 페이지를 돌려줍니다.
+ * kfree()에 필요하듯 객체로부터 그 페이지를 찾습니다: 슬랩은 페이지를 넘지
+ * 않습니다. hd 요청이 디스크 인터럽트에서 해제되므로 모든 작업은 인터럽트가
+ * 꺼진 상태로 실행됩니다.
+ */
+
+#include <stddef.h>
+
+#include <linux/kernel.h>
+#include <linux/mm.h>
+#include <linux/slab.h>
+#include <asm/system.h>
+
+#define BUFCTL_END	255
+
+struct slab {
+	struct slab * next, * prev;
+	struct kmem_cache * cache;
+	int inuse;
+	int free;			/* first free object, or BUFCTL_END */
+	unsigned char bufctl[0];	/* next free object after each one */
+};
+
+#define slab_obj(s,i) ((char *) (s) + (s)->cache->offset + (i) * (s)->cache->size)
+
+static struct kmem_cache cache_cache = {
+	"kmem_cache", sizeof(struct kmem_cache), 0, 0, NULL
+};
+
+static struct kmem_cache * cache_chain = &cache_cache;
+
+static struct kmem_cache * kmalloc_caches[7];	/* 32 .. KMALLOC_MAX */
+
+static void slab_unlink(struct slab ** list, struct slab * s)
+{
+	if (s->prev)
+		s->prev->next = s->next;
+	else
+		*list = s->next;
+	if (s->next)
+		s->next->prev = s->prev;
+}
+
+static void slab_link(struct slab ** list, struct slab * s)
+{
+	s->prev = NULL;
+	if ((s->next = *list))
+		s->next->prev = s;
+	*list = s;
+}
+
+/*
+ * cache_layout: As many objects as fit after the header and their index
+ * bytes, at most BUFCTL_END.
+ * cache_layout: 헤더와 인덱스 바이트 뒤에 들어가는 만큼의 객체이며, 최대
+ * BUFCTL_END개입니다.
+ */
+static void cache_layout(struct kmem_cache * cache)
+{
+	int num = (PAGE_SIZE - sizeof(struct slab)) / (cache->size + 1);
+
+	if (num > BUFCTL_END)
+		num = BUFCTL_END;
+	while ((((sizeof(struct slab) + num + 7) & ~7) + num * cache->size)
+	    > PAGE_SIZE)
+		num--;
+	cache->num = num;
+	cache->offset = (sizeof(struct slab) + num + 7) & ~7;
+}
+
+static struct slab * cache_grow(struct kmem_cache * cache)
+{
+	struct slab * s;
+	int i;
+
+	if (!(s = (struct slab *) get_free_page()))
+		return NULL;
+	s->cache = cache;
+	s->inuse = 0;
+	s->free = 0;
+	for (i = 0 ; i < cache->num ; i++) {
+		s->bufctl[i] = i+1;
+		if (cache->ctor)
+			cache->ctor(slab_obj(s, i));
+	}
+	s->bufctl[cache->num-1] = BUFCTL_END;
+	cache->nr_objs += cache->num;
+	return s;
+}
+
+/*
+ * kmem_cache_create: Makes a cache of 'size'-byte objects. Returns NULL if
+ * out of memory or if an object wouldn't fit a page.
+ * kmem_cache_create: 'size' 바이트 객체의 캐시를 만듭니다. 메모리가
+ * 부족하거나 객체가 한 페이지에 들어가지 않으면 NULL을 반환합니다.
+ */
+struct kmem_cache * kmem_cache_create(char * name, int size,
+	void (*ctor)(void *))
+{
+	struct kmem_cache * cache;
+	unsigned long flags;
+
+	size = (size + 3) & ~3;
+	if (size <= 0 || size > PAGE_SIZE/2)
+		return NULL;
+	if (!cache_cache.num)
+		cache_layout(&cache_cache);
+	if (!(cache = kmem_cache_alloc(&cache_cache)))
+		return NULL;
+	cache->name = name;
+	cache->size = size;
+	cache->ctor = ctor;
+	cache->partial = cache->full = cache->empty = NULL;
+	cache->nr_empty = 0;
+	cache->nr_objs = cache->nr_active = 0;
+	cache->shrink = NULL;
+	cache_layout(cache);
+	save_flags(flags);
+	cli();
+	cache->next = cache_chain;
+	cache_chain = cache;
+	restore_flags(flags);
+	return cache;
+}
+
+void * kmem_cache_alloc(struct kmem_cache * cache)
+{
+	struct slab * s;
+	unsigned long flags;
+	void * obj;
+
+	save_flags(flags);
+	cli();
+	if (!(s = cache->partial)) {
+		if ((s = cache->empty)) {
+			slab_unlink(&cache->empty, s);
+			cache->nr_empty--;
+		} else if (!(s = cache_grow(cache))) {
+			restore_flags(flags);
+			return NULL;
+		}
+		slab_link(&cache->partial, s);
+	}
+	obj = slab_obj(s, s->free);
+	s->free = s->bufctl[s->free];
+	if (++s->inuse == cache->num) {
+		slab_unlink(&cache->partial, s);
+		slab_link(&cache->full, s);
+	}
+	cache->nr_active++;
+	restore_flags(flags);
+	return obj;
+}
+
+void kmem_cache_free(struct kmem_cache * cache, void * obj)
+{
+	struct slab * s = (struct slab *) ((unsigned long) obj & ~(PAGE_SIZE-1));
+	unsigned long flags;
+	int i;
+
+	if (s->cache != cache)
+		panic("kmem_cache_free: object from another cache");
+	i = ((char *) obj - slab_obj(s, 0)) / cache->size;
+	save_flags(flags);
+	cli();
+	s->bufctl[i] = s->free;
+	s->free = i;
+	cache->nr_active--;
+	if (s->inuse-- == cache->num) {
+		slab_unlink(&cache->full, s);
+		slab_link(&cache->partial, s);
+	}
+	if (!s->inuse) {
+		slab_unlink(&cache->partial, s);
+		if (cache->nr_empty) {
+			cache->nr_objs -= cache->num;
+			free_page((unsigned long) s);
+		} else {
+			slab_link(&cache->empty, s);
+			cache->nr_empty++;
+		}
+	}
+	restore_flags(flags);
+}
+
+/*
+ * kmem_cache_reap: Called by the page allocator when it has run out, with
+ * interrupts off. Has the caches' shrinkers free unused objects, a slab's
+ * worth at a time, and gives back every empty slab, until some page comes
+ * free or there is nothing left to shrink. Returns the pages freed.
+ * kmem_cache_reap: 페이지 할당기가 바닥났을 때 인터럽트가 꺼진 상태로
+ * 호출됩니다. 캐시의 shrink 함수들이 사용하지 않는 객체를 한 번에 슬랩 하나
+ * 분량씩 해제하게 하고, 빈 슬랩을 모두 돌려주며, 페이지가 풀리거나 더 줄일
+ * 것이 없을 때까지 반복합니다. 해제한 페이지 수를 반환합니다.
+ */
+int kmem_cache_reap(void)
+{
+	struct kmem_cache * cache;
+	struct slab * s;
+	unsigned long flags;
+	int pages = 0, shrunk;
+
+	save_flags(flags);
+	cli();
+	do {
+		shrunk = 0;
+		for (cache = cache_chain ; cache ; cache = cache->next) {
+			if (cache->shrink && cache->shrink(cache->num))
+				shrunk = 1;
+			while ((s = cache->empty)) {
+				slab_unlink(&cache->empty, s);
+				cache->nr_empty--;
+				cache->nr_objs -= cache->num;
+				free_page((unsigned long) s);
+				pages++;
+			}
+		}
+	} while (!pages && shrunk);
+	restore_flags(flags);
+	return pages;
+}
+
+/*
+ * kmalloc: 'size' bytes from the smallest power-of-two cache that fits,
+ * NULL if it is larger than KMALLOC_MAX: use __get_free_pages() then.
+ * kmalloc: 들어맞는 가장 작은 2의 거듭제곱 캐시에서 'size' 바이트를 주며,
+ * KMALLOC_MAX보다 크면 NULL입니다: 그때는 __get_free_pages()를 사용하세요.
+ */
+void * kmalloc(unsigned int size)
+{
+	static char * names[7] = { "size-32", "size-64", "size-128",
+		"size-256", "size-512", "size-1024", "size-2048" };
+	int i = 0;
+
+	if (size > KMALLOC_MAX)
+		return NULL;
+	while ((32U << i) < size)
+		i++;
+	if (!kmalloc_caches[i] &&
+	    !(kmalloc_caches[i] = kmem_cache_create(names[i], 32 << i, NULL)))
+		return NULL;
+	return kmem_cache_alloc(kmalloc_caches[i]);
+}
+
+void kfree(void * obj)
+{
+	struct slab * s = (struct slab *) ((unsigned long) obj & ~(PAGE_SIZE-1));
+
+	if (obj)
+		kmem_cache_free(s->cache, obj);
+}